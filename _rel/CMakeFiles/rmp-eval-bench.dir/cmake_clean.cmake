@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/rmp-eval-bench.dir/bench/bench.cpp.o"
+  "CMakeFiles/rmp-eval-bench.dir/bench/bench.cpp.o.d"
+  "rmp-eval-bench"
+  "rmp-eval-bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rmp-eval-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
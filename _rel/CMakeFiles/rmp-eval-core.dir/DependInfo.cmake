@@ -0,0 +1,42 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/allocationguard.cpp" "CMakeFiles/rmp-eval-core.dir/source/allocationguard.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/allocationguard.cpp.o.d"
+  "/root/repo/source/checkpoint.cpp" "CMakeFiles/rmp-eval-core.dir/source/checkpoint.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/checkpoint.cpp.o.d"
+  "/root/repo/source/commandlineparser.cpp" "CMakeFiles/rmp-eval-core.dir/source/commandlineparser.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/commandlineparser.cpp.o.d"
+  "/root/repo/source/config.cpp" "CMakeFiles/rmp-eval-core.dir/source/config.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/config.cpp.o.d"
+  "/root/repo/source/cycletrace.cpp" "CMakeFiles/rmp-eval-core.dir/source/cycletrace.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/cycletrace.cpp.o.d"
+  "/root/repo/source/ethercatnictest.cpp" "CMakeFiles/rmp-eval-core.dir/source/ethercatnictest.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/ethercatnictest.cpp.o.d"
+  "/root/repo/source/ethtool.cpp" "CMakeFiles/rmp-eval-core.dir/source/ethtool.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/ethtool.cpp.o.d"
+  "/root/repo/source/eventlog.cpp" "CMakeFiles/rmp-eval-core.dir/source/eventlog.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/eventlog.cpp.o.d"
+  "/root/repo/source/ftracesnapshot.cpp" "CMakeFiles/rmp-eval-core.dir/source/ftracesnapshot.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/ftracesnapshot.cpp.o.d"
+  "/root/repo/source/nicthreads.cpp" "CMakeFiles/rmp-eval-core.dir/source/nicthreads.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/nicthreads.cpp.o.d"
+  "/root/repo/source/numa.cpp" "CMakeFiles/rmp-eval-core.dir/source/numa.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/numa.cpp.o.d"
+  "/root/repo/source/periodicity.cpp" "CMakeFiles/rmp-eval-core.dir/source/periodicity.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/periodicity.cpp.o.d"
+  "/root/repo/source/pingpong.cpp" "CMakeFiles/rmp-eval-core.dir/source/pingpong.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/pingpong.cpp.o.d"
+  "/root/repo/source/quantileestimator.cpp" "CMakeFiles/rmp-eval-core.dir/source/quantileestimator.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/quantileestimator.cpp.o.d"
+  "/root/repo/source/reporter.cpp" "CMakeFiles/rmp-eval-core.dir/source/reporter.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/reporter.cpp.o.d"
+  "/root/repo/source/rtarena.cpp" "CMakeFiles/rmp-eval-core.dir/source/rtarena.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/rtarena.cpp.o.d"
+  "/root/repo/source/rtthread.cpp" "CMakeFiles/rmp-eval-core.dir/source/rtthread.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/rtthread.cpp.o.d"
+  "/root/repo/source/scenario.cpp" "CMakeFiles/rmp-eval-core.dir/source/scenario.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/scenario.cpp.o.d"
+  "/root/repo/source/signalbench.cpp" "CMakeFiles/rmp-eval-core.dir/source/signalbench.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/signalbench.cpp.o.d"
+  "/root/repo/source/tailestimate.cpp" "CMakeFiles/rmp-eval-core.dir/source/tailestimate.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/tailestimate.cpp.o.d"
+  "/root/repo/source/timerlat.cpp" "CMakeFiles/rmp-eval-core.dir/source/timerlat.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/timerlat.cpp.o.d"
+  "/root/repo/source/timing.cpp" "CMakeFiles/rmp-eval-core.dir/source/timing.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/timing.cpp.o.d"
+  "/root/repo/source/waketimer.cpp" "CMakeFiles/rmp-eval-core.dir/source/waketimer.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/waketimer.cpp.o.d"
+  "/root/repo/source/workerprocess.cpp" "CMakeFiles/rmp-eval-core.dir/source/workerprocess.cpp.o" "gcc" "CMakeFiles/rmp-eval-core.dir/source/workerprocess.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,57 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/rmp-eval-core.dir/source/allocationguard.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/allocationguard.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/checkpoint.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/checkpoint.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/commandlineparser.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/commandlineparser.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/config.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/config.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/cycletrace.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/cycletrace.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/ethercatnictest.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/ethercatnictest.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/ethtool.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/ethtool.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/eventlog.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/eventlog.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/ftracesnapshot.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/ftracesnapshot.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/nicthreads.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/nicthreads.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/numa.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/numa.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/periodicity.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/periodicity.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/pingpong.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/pingpong.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/quantileestimator.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/quantileestimator.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/reporter.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/reporter.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/rtarena.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/rtarena.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/rtthread.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/rtthread.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/scenario.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/scenario.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/signalbench.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/signalbench.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/tailestimate.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/tailestimate.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/timerlat.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/timerlat.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/timing.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/timing.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/waketimer.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/waketimer.cpp.o.d"
+  "CMakeFiles/rmp-eval-core.dir/source/workerprocess.cpp.o"
+  "CMakeFiles/rmp-eval-core.dir/source/workerprocess.cpp.o.d"
+  "librmp-eval-core.a"
+  "librmp-eval-core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rmp-eval-core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/rmp-eval-tests.dir/tests/tests.cpp.o"
+  "CMakeFiles/rmp-eval-tests.dir/tests/tests.cpp.o.d"
+  "rmp-eval-tests"
+  "rmp-eval-tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rmp-eval-tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
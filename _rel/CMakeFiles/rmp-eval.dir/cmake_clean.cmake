@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/rmp-eval.dir/source/main.cpp.o"
+  "CMakeFiles/rmp-eval.dir/source/main.cpp.o.d"
+  "rmp-eval"
+  "rmp-eval.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rmp-eval.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
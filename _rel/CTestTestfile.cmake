@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_rel
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(rmp-eval-tests "/root/repo/_rel/rmp-eval-tests")
+set_tests_properties(rmp-eval-tests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;77;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(rmp-eval-bench-smoke "/root/repo/_rel/rmp-eval-bench" "--iterations" "1000")
+set_tests_properties(rmp-eval-bench-smoke PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;84;add_test;/root/repo/CMakeLists.txt;0;")
@@ -0,0 +1,181 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+// Microbenchmarks for the code that runs inside the RT threads once per cycle. Every call is timed
+// individually with the CPU cycle counter so that the tail (p99) is visible and not just the mean.
+// Run pinned to an isolated core for stable numbers, e.g. `taskset -c 3 rmp-eval-bench`.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <time.h>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "commandlineparser.h"
+#include "nictest.h"
+#include "quantileestimator.h"
+#include "reporter.h"
+
+namespace
+{
+  using namespace Evaluator;
+
+  // Raw cycle counter: TSC on x86, the virtual counter on AArch64, CLOCK_MONOTONIC_RAW elsewhere
+  inline uint64_t ReadCycleCounter()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    asm volatile("isb; mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+    return ToEpoch(now);
+#endif
+  }
+
+  // Keep the compiler from optimizing away a result or hoisting work across the timestamps
+  template <typename T>
+  inline void DoNotOptimize(const T& value)
+  {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  double MeasureCyclesPerNanosecond()
+  {
+    static constexpr auto CalibrationTime = std::chrono::milliseconds(100);
+    const auto startTime = std::chrono::steady_clock::now();
+    const uint64_t startCycles = ReadCycleCounter();
+    while (std::chrono::steady_clock::now() - startTime < CalibrationTime) {}
+    const uint64_t endCycles = ReadCycleCounter();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+    return static_cast<double>(endCycles - startCycles) / static_cast<double>(elapsed.count());
+  }
+
+  struct BenchResult
+  {
+    double Mean = 0;
+    uint64_t P50 = 0;
+    uint64_t P99 = 0;
+    uint64_t Max = 0;
+  };
+
+  // Times each call of `operation` separately, after a short warm-up. Results are in counter ticks.
+  BenchResult Measure(uint64_t iterations, const std::function<void(uint64_t)>& operation)
+  {
+    static constexpr uint64_t WarmupIterations = 1000;
+    for (uint64_t iteration = 0; iteration < WarmupIterations; ++iteration)
+    {
+      operation(iteration);
+    }
+
+    std::vector<uint64_t> samples(iterations);
+    for (uint64_t iteration = 0; iteration < iterations; ++iteration)
+    {
+      const uint64_t start = ReadCycleCounter();
+      operation(iteration);
+      samples[iteration] = ReadCycleCounter() - start;
+    }
+
+    BenchResult result;
+    for (uint64_t sample : samples) { result.Mean += static_cast<double>(sample); }
+    result.Mean /= static_cast<double>(iterations);
+    std::sort(samples.begin(), samples.end());
+    result.P50 = samples[iterations / 2];
+    result.P99 = samples[std::min(iterations - 1, iterations * 99 / 100)];
+    result.Max = samples.back();
+    return result;
+  }
+
+  void PrintResult(std::string_view name, const BenchResult& result, uint64_t overhead, double cyclesPerNanosecond)
+  {
+    auto toNanoseconds = [&](double ticks) { return std::max(0.0, ticks - static_cast<double>(overhead)) / cyclesPerNanosecond; };
+    std::cout << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << toNanoseconds(result.Mean)
+              << std::setw(10) << toNanoseconds(static_cast<double>(result.P50))
+              << std::setw(10) << toNanoseconds(static_cast<double>(result.P99))
+              << std::setw(12) << toNanoseconds(static_cast<double>(result.Max)) << "\n";
+  }
+} // end namespace
+
+
+
+int main(int argc, char* argv[])
+{
+  static constexpr uint64_t DefaultIterations = 1000000;
+  static constexpr uint64_t Period = 1000000;
+  static constexpr uint64_t BucketWidth = Period / 8;
+
+  uint64_t iterations = DefaultIterations;
+  bool showHelp = false;
+  std::vector<Evaluator::Argument> arguments;
+  Evaluator::AddArgument(arguments, {"--iterations", "-i"}, &iterations, "Timed calls per benchmark (default: " + std::to_string(DefaultIterations) + ")");
+  Evaluator::AddArgument(arguments, {"--help", "-h"}, &showHelp, "Show this help message");
+  if (!Evaluator::ParseArguments(arguments, argc, argv) || showHelp || iterations == 0)
+  {
+    Evaluator::PrintHelp(std::cout, arguments, "Microbenchmarks of the rmp-eval measurement hot path.");
+    return showHelp ? 0 : 1;
+  }
+
+  // Periods jittering around the target the way a real run does, so that branches are realistic
+  std::vector<uint64_t> periods(4096);
+  std::mt19937_64 generator(42);
+  std::normal_distribution<double> jitter(Period, Period * 0.02);
+  for (uint64_t& period : periods) { period = static_cast<uint64_t>(std::max(0.0, jitter(generator))); }
+  auto periodAt = [&periods](uint64_t iteration) { return periods[iteration % periods.size()]; };
+
+  const double cyclesPerNanosecond = MeasureCyclesPerNanosecond();
+  const uint64_t overhead = Measure(iterations, [](uint64_t iteration) { DoNotOptimize(iteration); }).P50;
+
+  std::cout << "Counter: " << std::setprecision(3) << cyclesPerNanosecond << " ticks/ns, timing overhead "
+            << overhead << " ticks (subtracted), " << iterations << " calls each\n\n";
+  std::cout << std::left << std::setw(36) << "Operation [ns/op]" << std::right
+            << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(12) << "max" << "\n";
+
+  PrintResult("GetBucketIndex", Measure(iterations, [&](uint64_t iteration)
+  {
+    DoNotOptimize(Evaluator::GetBucketIndex(periodAt(iteration) % Period, BucketWidth, Evaluator::BucketCount));
+  }), overhead, cyclesPerNanosecond);
+
+  Evaluator::QuantileEstimator median(0.5);
+  PrintResult("QuantileEstimator::AddObservation", Measure(iterations, [&](uint64_t iteration)
+  {
+    median.AddObservation(static_cast<double>(periodAt(iteration)));
+    DoNotOptimize(median);
+  }), overhead, cyclesPerNanosecond);
+
+  Evaluator::TimerReport localReport(Period, BucketWidth);
+  PrintResult("TimerReport::AddObservation", Measure(iterations, [&](uint64_t iteration)
+  {
+    localReport.AddObservation(periodAt(iteration), static_cast<int>(iteration));
+  }), overhead, cyclesPerNanosecond);
+
+  // This is what the RT threads do: every observation also publishes a snapshot for the live table
+  Evaluator::ReportData upload;
+  Evaluator::TimerReport uploadingReport(Period, BucketWidth, &upload);
+  PrintResult("TimerReport::AddObservation+upload", Measure(iterations, [&](uint64_t iteration)
+  {
+    uploadingReport.AddObservation(periodAt(iteration), static_cast<int>(iteration));
+    DoNotOptimize(upload);
+  }), overhead, cyclesPerNanosecond);
+
+  Evaluator::ProbeFrame frame;
+  PrintResult("BuildProbeFrame", Measure(iterations, [&](uint64_t)
+  {
+    Evaluator::BuildProbeFrame(frame);
+    DoNotOptimize(frame);
+  }), overhead, cyclesPerNanosecond);
+
+  return 0;
+}
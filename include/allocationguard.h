@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_ALLOCATIONGUARD_H
+#define RMP_EVAL_ALLOCATIONGUARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace Evaluator
+{
+  // Enforces "no heap allocation inside the measured loop of an RT thread". Builds configured with
+  // -DRMP_EVAL_ALLOCATION_GUARD=ON link an interposer for malloc/calloc/realloc/aligned_alloc and
+  // operator new that reports every allocation made while the calling thread is inside an RtSection.
+  // Other builds compile the sections to a counter increment and never see an allocation.
+  enum class AllocationGuardMode
+  {
+    Off,
+    Count, // record the call sites and report them through the event log when the section ends
+    Trap,  // print the backtrace of the first allocation and abort
+  };
+
+  const char* GetAllocationGuardModeName(AllocationGuardMode mode);
+  std::optional<AllocationGuardMode> ParseAllocationGuardMode(std::string_view name);
+
+  // True if the allocation interposer is linked in
+  bool IsAllocationGuardAvailable();
+
+  // Call once at startup, before any RT thread runs
+  void SetAllocationGuardMode(AllocationGuardMode mode);
+
+  // Marks the measured loop of the calling thread. Nesting is allowed. When the outermost section ends,
+  // the allocations it caught are posted to the event log under `source`.
+  class RtSection
+  {
+  public:
+    explicit RtSection(std::string_view source) noexcept;
+    ~RtSection();
+
+    // Disable copying
+    RtSection(const RtSection&) = delete;
+    // Disable copying
+    RtSection& operator=(const RtSection&) = delete;
+
+  private:
+    std::string_view source;
+  };
+
+  // Allocations caught in RT sections of the calling thread so far
+  uint64_t GetRtAllocationCount();
+
+  // Called by the interposer on every allocation, before it is served
+  void OnAllocation(size_t size) noexcept;
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_ALLOCATIONGUARD_H)
@@ -0,0 +1,37 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_CHECKPOINT_H
+#define RMP_EVAL_CHECKPOINT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "reporter.h"
+
+namespace Evaluator
+{
+  // Statistics of every row of a run, written periodically so that a long soak run that dies
+  // can be resumed with --resume instead of starting over.
+  struct Checkpoint
+  {
+    uint64_t Period = 0;       // nanoseconds
+    uint64_t BucketWidth = 0;  // nanoseconds
+    std::vector<std::pair<std::string, ReportData>> Rows;
+
+    const ReportData* Find(std::string_view label) const;
+  };
+
+  // Writes to a temporary file, syncs it and renames it over `path`, so a crash never leaves a torn checkpoint
+  void SaveCheckpoint(const std::string& path, const Checkpoint& checkpoint);
+
+  // Throws std::runtime_error if the file can't be read or is malformed
+  Checkpoint LoadCheckpoint(const std::string& path);
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_CHECKPOINT_H)
@@ -45,6 +45,12 @@ namespace Evaluator
     ClocksourceStable,
     SmtSiblingIsolated,
     TimerMigration,
+    NicNumaLocal,
+    NicCoalescingOff,
+    NicThreadPriority,
+    HighResTimers,
+    ClockReadCost,
+    TimerSlack,
   };
   
   enum class Status
@@ -66,6 +72,8 @@ namespace Evaluator
   {
     std::optional<int> cpu;
     std::optional<std::string> nic;
+    std::optional<int> sendPriority;    // RT priorities the test will use
+    std::optional<int> receivePriority;
   };
 
   // Core interfaces
@@ -95,7 +103,8 @@ namespace Evaluator
   std::string GetCpuInfo();
   std::string GetKernelInfo();
 
-  void ReportSystemConfiguration(int cpu, std::string_view nicName = DefaultNicName);
+  void ReportSystemConfiguration(int cpu, std::string_view nicName = DefaultNicName,
+    std::optional<int> sendPriority = std::nullopt, std::optional<int> receivePriority = std::nullopt);
 }
 
 
@@ -0,0 +1,109 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_CYCLETRACE_H
+#define RMP_EVAL_CYCLETRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Evaluator
+{
+  // Enough for several seconds of cycles at 8 kHz between two drains by the housekeeping thread
+  inline constexpr size_t DefaultCycleTraceCapacity = 1 << 16;
+
+  // Per-cycle wake lateness of the cyclic/sender thread, written to a file during a run (see --record) so
+  // that the run can later be replayed against other periods and compute budgets (see --replay).
+  // The RT thread pushes into a single-producer/single-consumer ring that makes no system call and never
+  // allocates; cycles recorded while the ring is full are counted and dropped. Like the EventLog ring, it
+  // is shared with a forked RT worker process.
+  class CycleTrace
+  {
+  public:
+    // Creates `path` and writes the header. Throws std::runtime_error on failure.
+    CycleTrace(const std::string& path, uint64_t period, size_t capacity = DefaultCycleTraceCapacity); // rounded up to a power of two
+    ~CycleTrace();
+
+    // Disable copying
+    CycleTrace(const CycleTrace&) = delete;
+    // Disable copying
+    CycleTrace& operator=(const CycleTrace&) = delete;
+
+    // Only from the one recording RT thread. `lateness` is the wake time minus the intended wake time.
+    bool Record(uint64_t lateness) noexcept;
+
+    // Append everything recorded so far to the file. Only one thread may flush at a time.
+    // Returns the number of cycles written.
+    size_t Flush();
+
+    // Flush, note the dropped count and close the file. Throws std::runtime_error if the file can't be written.
+    void Close();
+
+    uint64_t Recorded() const { return written; }
+    uint64_t Dropped() const { return ring->Dropped.load(std::memory_order_relaxed); }
+
+    // Move the ring to NUMA memory `node`, see BindMemoryToNode(). Call before a worker process forks.
+    void BindToNode(int node);
+
+  private:
+    static constexpr size_t CacheLineSize = 64;
+
+    // Both positions, followed by the slots in the same mapping
+    struct Ring
+    {
+      alignas(CacheLineSize) std::atomic<uint64_t> WritePosition = 0;
+      std::atomic<uint64_t> Dropped = 0;
+      alignas(CacheLineSize) std::atomic<uint64_t> ReadPosition = 0;
+    };
+
+    const uint64_t mask;
+    size_t mappingSize = 0;
+    Ring* ring = nullptr;
+    uint64_t* slots = nullptr;
+    std::string path;
+    std::ofstream file;
+    uint64_t written = 0;
+  };
+
+  // A trace read back from a --record file
+  struct CycleRecording
+  {
+    uint64_t Period = 0;            // nanoseconds
+    uint64_t Dropped = 0;           // cycles lost because the ring was full
+    std::vector<uint64_t> Lateness; // nanoseconds, one per recorded cycle in order
+  };
+
+  // Throws std::runtime_error if the file can't be read or is malformed
+  CycleRecording LoadCycleRecording(const std::string& path);
+
+  // Outcome of replaying a recording at one candidate period and compute budget
+  struct ReplayResult
+  {
+    uint64_t Period = 0;       // candidate period in nanoseconds
+    uint64_t Budget = 0;       // compute time per cycle in nanoseconds
+    uint64_t BucketWidth = 0;  // base bucket width in nanoseconds, an eighth of the period as in the live tool
+    uint64_t Cycles = 0;
+    uint64_t MaxLatency = 0;   // worst start-to-start interval minus the period, as the live tool measures it
+    uint64_t Misses = 0;       // cycles whose compute finished after the next cycle's release
+    int64_t MinSlack = 0;      // deadline minus finish of the tightest cycle, negative if it missed
+    int64_t MeanSlack = 0;
+
+    // Passes when no cycle missed its deadline and the worst cycle is no worse than "Good", as RunVerdict
+    bool Passed() const;
+  };
+
+  // Cycle i is released at i * period and starts `lateness[i]` later, or when cycle i-1's compute
+  // finishes if that is later still, and then computes for `budget`. Its deadline is the next release.
+  // The recorded lateness is assumed not to depend on the period.
+  ReplayResult ReplayCycles(const std::vector<uint64_t>& lateness, uint64_t period, uint64_t budget);
+
+  void PrintReplayTable(std::ostream& stream, const std::vector<ReplayResult>& results);
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_CYCLETRACE_H)
@@ -0,0 +1,127 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_ETHTOOL_H
+#define RMP_EVAL_ETHTOOL_H
+
+#include <linux/ethtool.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Evaluator
+{
+  // What to do with the NIC's interrupt coalescing for the duration of a run
+  enum class CoalescingMode
+  {
+    Keep, // leave the driver's settings alone
+    Rt,   // no time-based moderation, at most one frame per interrupt, no adaptive modes; restored afterward
+  };
+
+  const char* GetCoalescingModeName(CoalescingMode mode);
+  std::optional<CoalescingMode> ParseCoalescingMode(std::string_view name);
+
+  // A failed SIOCETHTOOL ioctl. `Error` is its errno, EOPNOTSUPP if the driver doesn't support the command.
+  struct EthtoolError : std::runtime_error
+  {
+    EthtoolError(const std::string& message, int error) : std::runtime_error(message), Error(error) {}
+
+    int Error;
+  };
+
+  // Interrupt coalescing through the SIOCETHTOOL ioctl (ETHTOOL_GCOALESCE/ETHTOOL_SCOALESCE), the same
+  // interface `ethtool -c/-C` uses. Both throw EthtoolError if the ioctl fails and std::runtime_error
+  // for an invalid interface name.
+  ethtool_coalesce GetCoalescing(std::string_view nic);
+  void SetCoalescing(std::string_view nic, const ethtool_coalesce& settings);
+
+  // `settings` with RX/TX moderation turned off. Fields are only ever lowered, since drivers reject a
+  // non-zero value for a parameter they don't support.
+  ethtool_coalesce GetRtCoalescing(const ethtool_coalesce& settings);
+
+  // True if coalescing can hold back a received frame: rx-usecs, or adaptive moderation in either direction
+  bool DelaysReceive(const ethtool_coalesce& settings);
+
+  // In `ethtool -C` argument syntax, e.g. "rx-usecs 3 rx-frames 0 tx-usecs 0 tx-frames 1 adaptive-rx off adaptive-tx off"
+  std::string DescribeCoalescing(const ethtool_coalesce& settings);
+
+  // Descriptor ring sizes through ETHTOOL_GRINGPARAM/ETHTOOL_SRINGPARAM, like `ethtool -g/-G`
+  ethtool_ringparam GetRingParameters(std::string_view nic);
+  void SetRingParameters(std::string_view nic, const ethtool_ringparam& settings);
+
+  // A NIC parameter that --nic-sweep can vary, named as in `ethtool -C/-G`
+  enum class NicSetting
+  {
+    RxUsecs,
+    RxFrames,
+    TxUsecs,
+    TxFrames,
+    RxRing,
+    TxRing,
+  };
+
+  const char* GetNicSettingName(NicSetting setting);
+  std::optional<NicSetting> ParseNicSetting(std::string_view name);
+
+  using NicSettingValues = std::vector<std::pair<NicSetting, uint32_t>>;
+
+  // "rx-usecs 0 rx-ring 256"
+  std::string DescribeNicSettings(const NicSettingValues& values);
+
+  // Expand a grid such as "rx-usecs=0,16,64;rx-ring=64,256" into every combination of its values,
+  // varying the last setting fastest. Throws std::runtime_error on a malformed grid.
+  std::vector<NicSettingValues> ParseNicSweepGrid(std::string_view grid);
+
+  // Saves a NIC's coalescing and/or ring sizes and restores them when destroyed. Apply() always starts
+  // from the saved settings, with adaptive coalescing off so that the fixed values take effect. If the
+  // driver can't report a group of settings, Apply() fails with that reason for any value in the group.
+  class ScopedNicSettings
+  {
+  public:
+    ScopedNicSettings(std::string nic, bool includeCoalescing, bool includeRings);
+    ~ScopedNicSettings();
+
+    // Disable copying
+    ScopedNicSettings(const ScopedNicSettings&) = delete;
+    // Disable copying
+    ScopedNicSettings& operator=(const ScopedNicSettings&) = delete;
+
+    // Throws std::runtime_error if the driver rejects the values
+    void Apply(const NicSettingValues& values);
+
+  private:
+    std::string nic;
+    std::optional<ethtool_coalesce> coalescing;
+    std::optional<ethtool_ringparam> rings;
+    std::string coalescingError;
+    std::string ringError;
+  };
+
+  // Applies GetRtCoalescing() to a NIC and restores the original settings when destroyed
+  class ScopedRtCoalescing
+  {
+  public:
+    explicit ScopedRtCoalescing(std::string nic);
+    ~ScopedRtCoalescing();
+
+    // Disable copying
+    ScopedRtCoalescing(const ScopedRtCoalescing&) = delete;
+    // Disable copying
+    ScopedRtCoalescing& operator=(const ScopedRtCoalescing&) = delete;
+
+    const ethtool_coalesce& Original() const { return original; }
+    const ethtool_coalesce& Applied() const { return applied; }
+
+  private:
+    std::string nic;
+    ethtool_coalesce original = {};
+    ethtool_coalesce applied = {};
+  };
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_ETHTOOL_H)
@@ -0,0 +1,98 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_EVENTLOG_H
+#define RMP_EVAL_EVENTLOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+
+namespace Evaluator
+{
+  enum class EventLevel : uint8_t
+  {
+    State,     // thread started, warm-up done, stopped; shown in verbose mode only
+    Threshold, // a cycle landed in the worst latency category
+    Error,
+  };
+
+  // Fixed-size record, copied by value into the ring so that posting never allocates
+  struct Event
+  {
+    static constexpr size_t SourceSize = 16;
+    static constexpr size_t MessageSize = 96;
+
+    uint64_t Time = 0;         // CLOCK_MONOTONIC nanoseconds
+    int64_t Index = -1;        // cycle index, -1 if not applicable
+    int64_t Nanoseconds = -1;  // measured duration, -1 if not applicable
+    int Error = 0;             // errno, 0 if not applicable
+    EventLevel Level = EventLevel::State;
+    char Source[SourceSize] = {};
+    char Message[MessageSize] = {};
+  };
+
+  // Bounded multi-producer/single-consumer ring for diagnostics from the RT threads. Posting is lock-free,
+  // touches only preallocated memory and makes no system call (the clock read is a vDSO call), so RT
+  // threads can report errors without blocking on the console. A non-RT thread drains the ring and does
+  // the formatting. Events posted while the ring is full are counted and dropped. Based on Dmitry Vyukov's
+  // bounded MPMC queue. The ring is a shared anonymous mapping, so a forked RT worker process posts into
+  // the same log its parent drains.
+  class EventLog
+  {
+  public:
+    explicit EventLog(size_t capacity); // rounded up to a power of two
+    ~EventLog();
+
+    // Disable copying
+    EventLog(const EventLog&) = delete;
+    // Disable copying
+    EventLog& operator=(const EventLog&) = delete;
+
+    // Safe from any thread, including SCHED_FIFO/SCHED_DEADLINE ones. Longer strings are truncated.
+    bool Post(EventLevel level, std::string_view source, std::string_view message,
+      int64_t index = -1, int64_t nanoseconds = -1, int error = 0) noexcept;
+
+    // Only one thread may drain at a time. `startTime` (CLOCK_MONOTONIC ns) is the zero for the printed
+    // timestamps. State events are consumed but only printed if `includeState` is set.
+    // Returns the number of lines printed.
+    int Drain(std::ostream& stream, uint64_t startTime, bool includeState);
+
+    uint64_t Dropped() const { return ring->Dropped.load(std::memory_order_relaxed); }
+
+    // Move the ring to NUMA memory `node`, see BindMemoryToNode(). Call before a worker process forks.
+    void BindToNode(int node);
+
+  private:
+    static constexpr size_t CacheLineSize = 64;
+
+    struct Cell
+    {
+      std::atomic<uint64_t> Sequence;
+      Event Data;
+    };
+
+    // Producer state, followed by the cells in the same mapping
+    struct Ring
+    {
+      alignas(CacheLineSize) std::atomic<uint64_t> EnqueuePosition = 0;
+      std::atomic<uint64_t> Dropped = 0;
+    };
+
+    const uint64_t mask;
+    size_t mappingSize = 0;
+    Ring* ring = nullptr;
+    Cell* cells = nullptr;
+    uint64_t dequeuePosition = 0; // consumer side, only used by the draining thread
+    uint64_t reportedDropped = 0;
+  };
+
+  // Process-wide log used by the RT threads and the NIC test
+  EventLog& GetEventLog();
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_EVENTLOG_H)
@@ -0,0 +1,99 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_FTRACESNAPSHOT_H
+#define RMP_EVAL_FTRACESNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Evaluator
+{
+  // Per-CPU ring of the tracefs instance. At a few hundred events per millisecond this holds the last
+  // tens of milliseconds before a spike, which is what explains it.
+  inline constexpr size_t DefaultSnapshotBufferKilobytes = 512;
+  // Each snapshot is a text file of up to a few MB; later spikes are only counted
+  inline constexpr uint64_t MaximumSnapshots = 100;
+
+  enum class SnapshotDecision
+  {
+    Ignore, // the cycle was not late enough
+    Skip,   // late, but a snapshot is still unsaved or MaximumSnapshots were taken
+    Take,
+  };
+
+  // Whether FtraceSnapshot::Check() takes a snapshot of a cycle `latency` late, given whether one is
+  // still waiting to be saved and how many were taken so far
+  SnapshotDecision DecideSnapshot(uint64_t latency, uint64_t threshold, bool pending, uint64_t triggered);
+
+  // Scheduler, interrupt and hrtimer events of the RT CPUs in a private tracefs instance (see --snapshot).
+  // The instance keeps tracing into a small ring buffer. When a cycle of the cyclic/sender thread is later
+  // than the threshold, that thread writes a trace marker and swaps the ring into the instance's snapshot
+  // buffer, so the snapshot ends with the late cycle. The housekeeping thread writes the snapshot to
+  // `snapshot-<cycle index>.txt` and clears it; spikes while a snapshot is still unsaved are only counted.
+  // The state is shared with a forked RT worker process like the EventLog ring. The tracefs instance is
+  // removed again by the destructor.
+  class FtraceSnapshot
+  {
+  public:
+    // Creates `directory` if needed and sets up the instance. Throws std::runtime_error if tracefs is not
+    // mounted or the instance can't be configured.
+    FtraceSnapshot(const std::string& directory, const std::vector<int>& cpus, uint64_t threshold,
+      size_t bufferKilobytes = DefaultSnapshotBufferKilobytes);
+    ~FtraceSnapshot();
+
+    // Disable copying
+    FtraceSnapshot(const FtraceSnapshot&) = delete;
+    // Disable copying
+    FtraceSnapshot& operator=(const FtraceSnapshot&) = delete;
+
+    // Only from the one RT thread. Takes a snapshot if `latency` (period minus target) reaches the
+    // threshold and no snapshot is waiting to be saved. Makes two writes to tracefs, but only for a cycle
+    // that is already late. Returns true if a snapshot was taken.
+    bool Check(uint64_t latency, uint64_t index) noexcept;
+
+    // Write out the snapshot waiting to be saved, if any. Only one thread may save at a time.
+    // Returns the cycle index + 1 of the saved snapshot, 0 if there was none.
+    // Throws std::runtime_error if the file can't be written; the snapshot is released either way.
+    uint64_t Save();
+
+    uint64_t Threshold() const { return threshold; }
+    const std::string& Directory() const { return directory; }
+    uint64_t Saved() const { return saved; }
+    uint64_t Skipped() const { return state->Skipped.load(std::memory_order_relaxed); }
+
+  private:
+    struct State
+    {
+      std::atomic<uint64_t> Pending = 0;   // cycle index + 1 of the unsaved snapshot, 0 if none
+      std::atomic<uint64_t> Triggered = 0;
+      std::atomic<uint64_t> Skipped = 0;   // spikes while a snapshot was pending or after MaximumSnapshots
+    };
+
+    void Remove() noexcept;
+
+    std::string directory;
+    std::string instance;  // path of the tracefs instance
+    uint64_t threshold = 0;
+    State* state = nullptr;
+    int snapshotFd = -1;
+    int markerFd = -1;
+    uint64_t saved = 0;
+  };
+
+  // Mount point of tracefs. Throws std::runtime_error if it is not mounted.
+  std::string FindTracefs();
+
+  // Write a tracefs control file. Throws std::runtime_error naming the file and value on failure.
+  void WriteTracefs(const std::string& path, std::string_view value);
+
+  // tracing_cpumask format: hexadecimal, comma separated groups of 32 CPUs, highest first, e.g. "1,00000004"
+  std::string FormatCpuMask(const std::vector<int>& cpus);
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_FTRACESNAPSHOT_H)
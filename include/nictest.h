@@ -6,13 +6,22 @@
 #ifndef RMP_EVAL_NICTEST_H
 #define RMP_EVAL_NICTEST_H
 
+#include <algorithm>
+#include <array>
 #include <condition_variable>
 #include <cstdint>
 #include <mutex>
 #include <string>
 #include <limits>
 
+#include "cycletrace.h"
+#include "ethtool.h"
+#include "ftracesnapshot.h"
+#include "nicthreads.h"
+#include "numa.h"
+#include "periodicity.h"
 #include "reporter.h"
+#include "waketimer.h"
 
 namespace Evaluator
 {
@@ -56,6 +65,28 @@ namespace Evaluator
     RunningStats SoftwareDeltaNanoseconds; // inter-arrival using software timestamps
   };
 
+  enum class SchedulerPolicy
+  {
+    Fifo,     // SCHED_FIFO with a fixed priority
+    Deadline, // SCHED_DEADLINE (EDF + CBS) with runtime/deadline/period derived from the send sleep
+  };
+
+  enum class WorkerIsolation
+  {
+    Thread,  // RT threads run inside the main process
+    Process, // RT threads run in a forked child and publish statistics through shared memory
+  };
+
+  // Parts of one cyclic/sender cycle, timed separately in verbose mode
+  enum class CyclePhase
+  {
+    Wake,      // from the intended wake-up time to running again
+    Handshake, // waiting in EthercatNicTest::Send() for the receiver to be ready, NIC test only
+    Send,      // the send() system call, NIC test only
+    Post,      // from the end of Send() to going back to sleep: statistics and next wake-up time
+  };
+  inline constexpr size_t CyclePhaseCount = 4;
+
   struct TestParameters
   {
     std::string NicName;
@@ -67,10 +98,41 @@ namespace Evaluator
     int ReceiveCpu = 0;
     ReportData* SendData = nullptr;
     ReportData* ReceiveData = nullptr;
+    ReportData* SendOverhead = nullptr;    // instrumentation cost per cycle, shown in verbose mode
+    ReportData* ReceiveOverhead = nullptr;
+    HandoffHistogram* Handoff = nullptr;   // receiver-to-sender wake latency, NIC test only
+    CycleTrace* Trace = nullptr;           // per-cycle wake lateness of the cyclic/sender thread, see --record
+    LatencySeries* Series = nullptr;       // decimated latency of the cyclic/sender thread, see --periodicity
+    FtraceSnapshot* Snapshot = nullptr;    // kernel trace of the RT CPUs around late cyclic/sender cycles, see --snapshot
+    std::array<ReportData*, CyclePhaseCount> Phases = {}; // per-phase duration of the sender cycle, verbose mode only
     bool IsVerbose = false;
+    bool TrackReceiveP99 = false;          // estimate the receive p99, see --nic-sweep
+    bool KernelTimerlat = false;           // run the kernel's timerlat tracer on the send CPU alongside, see --timerlat
     uint64_t BucketWidth = 0;
+    SchedulerPolicy Scheduler = SchedulerPolicy::Fifo;
+    uint64_t DeadlineRuntime = 0; // SCHED_DEADLINE runtime in nanoseconds, 0 = a quarter of the send sleep
+    WakeMechanism Wake = WakeMechanism::Nanosleep;
+    WorkerIsolation Isolation = WorkerIsolation::Thread;
+    CoalescingMode Coalescing = CoalescingMode::Keep;
+    int NicThreadPriority = KeepNicThreadPriority; // SCHED_FIFO priority for the NIC's IRQ/NAPI threads during the run
+    int MemoryNode = LocalMemoryNode; // NUMA node of the RT threads' memory, or LocalMemoryNode/UnboundMemoryNode
+    uint64_t Warmup = 0; // nanoseconds at the start of a run excluded from statistics
+    const ReportData* SendResume = nullptr;    // statistics to continue from, see --resume
+    const ReportData* ReceiveResume = nullptr;
+
+    // Number of leading cycles excluded from statistics; the first cycle is always excluded
+    uint64_t WarmupCycles() const
+    {
+      uint64_t cycles = SendSleep > 0 ? (Warmup + SendSleep - 1) / SendSleep : 0;
+      return std::max<uint64_t>(cycles, 1);
+    }
   };
 
+  // Broadcast EtherCAT frame sent once per cycle by EthercatNicTest::Send()
+  inline constexpr size_t ProbeFrameSize = 29;
+  using ProbeFrame = std::array<unsigned char, ProbeFrameSize>;
+  void BuildProbeFrame(ProbeFrame& frame);
+
   class EthercatNicTest : public INicTest
   {
     int socketDescriptor;
@@ -79,9 +141,12 @@ namespace Evaluator
     CadenceStats stats;
     uint64_t sendIteration = 0;
     uint64_t receiveIteration = 0;
+    uint64_t notifyNanoseconds = 0; // when the receiver last signalled the sender, guarded by `mutex`
     TestParameters params;
     TimerReport hardwareReport;
     TimerReport softwareReport;
+    OverheadReport handshakePhase;
+    OverheadReport sendPhase;
 
     struct PrevStats
     {
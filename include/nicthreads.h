@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_NICTHREADS_H
+#define RMP_EVAL_NICTHREADS_H
+
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <vector>
+
+namespace Evaluator
+{
+  // Value of TestParameters::NicThreadPriority that leaves the NIC's kernel threads alone
+  inline constexpr int KeepNicThreadPriority = 0;
+
+  // A kernel thread that moves the NIC's frames: a threaded IRQ handler (irq/<N>-<name>, the default for
+  // every IRQ on PREEMPT_RT) or a threaded NAPI poller (napi/<nic>-<id>, see /sys/class/net/<nic>/threaded)
+  struct NicKernelThread
+  {
+    pid_t Pid = 0;
+    std::string Name;
+    int Policy = 0;      // SCHED_OTHER, SCHED_FIFO, ...
+    int Priority = 0;    // RT priority, 0 for non-RT policies
+    std::string Cpus;    // allowed CPUs as a list, e.g. "0-3"
+  };
+
+  // IRQ numbers whose /proc/interrupts line names the NIC
+  std::set<int> ParseNicIrqs(std::string_view interrupts, std::string_view nic);
+
+  // True if `comm` is the IRQ thread of one of `irqs` or a NAPI thread of the NIC. Matches the prefix only,
+  // since the kernel truncates thread names to 15 characters.
+  bool IsNicKernelThread(std::string_view comm, std::string_view nic, const std::set<int>& irqs);
+
+  // All IRQ and NAPI threads of the NIC that are currently running, sorted by name
+  std::vector<NicKernelThread> FindNicKernelThreads(std::string_view nic);
+
+  // e.g. "FIFO 50", "OTHER"
+  std::string DescribeSchedulingPolicy(int policy, int priority);
+
+  // The NIC thread priority the tuning and the config check aim for: just below the lower of the two RT
+  // threads, so that traffic on the NIC never preempts the measuring threads but is handled as soon as
+  // they block.
+  int GetRecommendedNicThreadPriority(int sendPriority, int receivePriority);
+
+  // Moves all IRQ and NAPI threads of a NIC to SCHED_FIFO at `priority` and restores each thread's
+  // original policy and priority when destroyed. Throws std::runtime_error if no thread is found.
+  class ScopedNicThreadPriority
+  {
+  public:
+    ScopedNicThreadPriority(std::string_view nic, int priority);
+    ~ScopedNicThreadPriority();
+
+    // Disable copying
+    ScopedNicThreadPriority(const ScopedNicThreadPriority&) = delete;
+    // Disable copying
+    ScopedNicThreadPriority& operator=(const ScopedNicThreadPriority&) = delete;
+
+    const std::vector<NicKernelThread>& Original() const { return original; }
+
+  private:
+    void Restore();
+
+    std::vector<NicKernelThread> original;
+    size_t applied = 0; // leading entries of `original` that were changed
+  };
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_NICTHREADS_H)
@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_NUMA_H
+#define RMP_EVAL_NUMA_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Evaluator
+{
+  // Values of TestParameters::MemoryNode besides a node number
+  inline constexpr int LocalMemoryNode = -1;   // the node of each RT thread's CPU
+  inline constexpr int UnboundMemoryNode = -2; // leave placement to the kernel's default policy
+
+  // "local", "none" or a node number
+  std::string GetMemoryNodeName(int memoryNode);
+  std::optional<int> ParseMemoryNode(std::string_view name);
+
+  // Topology from sysfs. All return empty on kernels built without NUMA support.
+  std::vector<int> GetOnlineNumaNodes();
+  std::optional<int> GetCpuNumaNode(int cpu);
+  std::optional<int> GetNicNumaNode(std::string_view nic); // empty if the device reports no affinity (-1)
+
+  // Resolve LocalMemoryNode for `cpu`. Returns UnboundMemoryNode if there is nothing to bind to.
+  int ResolveMemoryNode(int memoryNode, int cpu);
+
+  // Bind an existing mapping to `node` with mbind(), moving pages that are already faulted in.
+  // Called through syscall() so that libnuma isn't needed. Throws std::runtime_error on failure.
+  void BindMemoryToNode(void* address, size_t length, int node);
+
+  // Makes the calling thread's new pages prefer `node` with set_mempolicy() for the lifetime of the
+  // object, then restores the default policy. Does nothing for UnboundMemoryNode.
+  class ScopedMemoryNode
+  {
+  public:
+    explicit ScopedMemoryNode(int node);
+    ~ScopedMemoryNode();
+
+    // Disable copying
+    ScopedMemoryNode(const ScopedMemoryNode&) = delete;
+    // Disable copying
+    ScopedMemoryNode& operator=(const ScopedMemoryNode&) = delete;
+
+  private:
+    bool active = false;
+  };
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_NUMA_H)
@@ -0,0 +1,101 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_PERIODICITY_H
+#define RMP_EVAL_PERIODICITY_H
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace Evaluator
+{
+  // Latency series resolution. Fine enough to place a 1 s or 4 s disturbance to a few milliseconds,
+  // coarse enough that 2^17 windows cover the last 21 minutes of a run.
+  inline constexpr uint64_t DefaultSeriesWindow = 10'000'000;
+  inline constexpr size_t DefaultSeriesCapacity = 1 << 17;
+  inline constexpr size_t DefaultSpikeCapacity = 1 << 12;
+
+  // Per-cycle latency of the cyclic/sender thread decimated to the maximum per window, plus the times of
+  // the cycles that reached the spike threshold, for the periodicity analysis after the run (see
+  // --periodicity). Add() only writes preallocated memory and makes no system call. Both are rings that
+  // keep the most recent windows and spikes, in one mapping shared with a forked RT worker process like the
+  // EventLog ring. Read only once the recording thread stopped.
+  class LatencySeries
+  {
+  public:
+    explicit LatencySeries(size_t windowCapacity = DefaultSeriesCapacity, size_t spikeCapacity = DefaultSpikeCapacity); // rounded up to powers of two
+    ~LatencySeries();
+
+    // Disable copying
+    LatencySeries(const LatencySeries&) = delete;
+    // Disable copying
+    LatencySeries& operator=(const LatencySeries&) = delete;
+
+    // Forget everything recorded and start a new run. Windows are never shorter than one cycle.
+    void Reset(uint64_t window, uint64_t spikeThreshold);
+
+    // Only from the one recording RT thread. `time` is CLOCK_MONOTONIC, `latency` the period minus the target.
+    void Add(uint64_t time, uint64_t latency) noexcept;
+
+    uint64_t Window() const { return state->Window; }
+    uint64_t SpikeThreshold() const { return state->SpikeThreshold; }
+    uint64_t SpikeCount() const { return state->Spikes; }
+
+    // Window maxima in time order, 0 for windows without a measured cycle
+    std::vector<uint64_t> GetWindows() const;
+
+    // Times of the most recent spikes, oldest first
+    std::vector<uint64_t> GetSpikeTimes() const;
+
+    // Move the series to NUMA memory `node`, see BindMemoryToNode(). Call before a worker process forks.
+    void BindToNode(int node);
+
+  private:
+    struct Slot
+    {
+      uint64_t Window;  // window number + 1, 0 if never written
+      uint64_t Max;
+    };
+
+    // Written by the recording thread, followed by the slots and the spike times in the same mapping
+    struct State
+    {
+      uint64_t Window = DefaultSeriesWindow;
+      uint64_t SpikeThreshold = std::numeric_limits<uint64_t>::max(); // no spikes until Reset()
+      uint64_t Start = 0;       // time of the first Add(), 0 before it
+      uint64_t LastWindow = 0;  // window number of the latest Add()
+      uint64_t Spikes = 0;
+    };
+
+    const uint64_t windowMask;
+    const uint64_t spikeMask;
+    size_t mappingSize = 0;
+    State* state = nullptr;
+    Slot* slots = nullptr;
+    uint64_t* spikeTimes = nullptr;
+  };
+
+  // A disturbance that repeats with a fixed period
+  struct PeriodicComponent
+  {
+    double PeriodSeconds = 0;
+    double Correlation = 0;     // autocorrelation of the window series at the period, 0-1
+    uint64_t Amplitude = 0;     // peak of the series folded at the period above the series median, nanoseconds
+    uint64_t MatchedSpikes = 0; // spike intervals that are a whole number of periods; they refine the period
+  };
+
+  // Dominant periods of a window series by autocorrelation (computed with an FFT), strongest first. Each
+  // period found is subtracted before searching for the next, so a second disturbance at a multiple of the
+  // first is still found. Periods are refined with the spike times when enough of them fit.
+  std::vector<PeriodicComponent> FindPeriodicComponents(const std::vector<uint64_t>& windows, uint64_t window,
+    const std::vector<uint64_t>& spikeTimes);
+
+  void PrintPeriodicity(std::ostream& stream, std::string_view label, const LatencySeries& series);
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_PERIODICITY_H)
@@ -0,0 +1,48 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_PINGPONG_H
+#define RMP_EVAL_PINGPONG_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Evaluator
+{
+  inline constexpr uint64_t DefaultPingPongRoundTrips = 100'000;
+
+  // Round-trip latency of one cache line bounced between the RT CPU and another CPU, see --cache-matrix
+  struct PingPongResult
+  {
+    int Cpu = -1;
+    std::string Relation;     // where `Cpu` sits relative to the RT CPU, e.g. "SMT sibling", "other package"
+    std::string Error;        // why the pair could not be measured; empty on success
+    uint64_t RoundTrips = 0;
+    uint64_t Median = 0;      // nanoseconds
+    uint64_t P99 = 0;
+    uint64_t Max = 0;
+  };
+
+  // CPUs this process may run on, in ascending order
+  std::vector<int> GetAllowedCpus();
+
+  // "SMT sibling", "same package", "other package", with the core type on hybrid CPUs, e.g. "same package, E-core"
+  std::string DescribeCpuRelation(int rtCpu, int cpu);
+
+  // Bounce a cache line between `rtCpu` and `cpu` `roundTrips` times. A SCHED_FIFO RtThread on each CPU
+  // spins until the line holds its turn and then hands it back, so a round trip is two cache-line
+  // transfers. Each round trip is timed on the RT CPU, less the cost of reading the clock. Both CPUs are
+  // busy for the duration. Errors, including a partner that never responds or zero `roundTrips`, end up
+  // in Error.
+  PingPongResult MeasureCacheLinePingPong(int rtCpu, int cpu, int priority, uint64_t roundTrips);
+
+  // One row per CPU, marking the CPU with the lowest median as the best partner for the RT CPU
+  void PrintPingPongMatrix(std::ostream& stream, int rtCpu, const std::vector<PingPongResult>& results);
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_PINGPONG_H)
@@ -11,7 +11,11 @@
 #include <functional>
 #include <iostream>
 #include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <time.h>
+#include <vector>
 
 #include "quantileestimator.h"
 
@@ -19,8 +23,12 @@
 namespace Evaluator
 {
   inline constexpr uint64_t NanoPerSec = 1e9;
+  inline constexpr double NanoToMicro = 0.001;
   inline constexpr size_t BucketCount = 5; // 5 buckets
 
+  // Latency categories double in width: [0, w), [w, 2w), [2w, 4w), [4w, 8w), >= 8w for bucket width w
+  size_t GetBucketIndex(uint64_t element, uint64_t bucketWidth, size_t bucketCount);
+
   struct BucketColorScheme
   {
     static inline constexpr char boldRed[] = "\033[38;5;196m";
@@ -50,6 +58,9 @@ namespace Evaluator
 
   struct ReportData
   {
+    // Odd while PublishReportData() is writing the fields below
+    uint64_t sequence = 0;
+
     uint64_t min = std::numeric_limits<uint64_t>::max();
     uint64_t max = 0;
     uint64_t sum = 0;
@@ -57,6 +68,7 @@ namespace Evaluator
     int maxIndex = -1;
     uint64_t observations = 0;
     double median = 0;
+    double p99 = 0;       // 99th percentile estimate if TimerReport::TrackP99() was called, not kept in checkpoints
     uint64_t target = 0;
 
     // The "base bucket width". Bucket widths don't scale linearly
@@ -68,8 +80,31 @@ namespace Evaluator
     //   [4] [500'000, +inf)
     uint64_t bucketWidth = 0;
     uint64_t buckets[BucketCount] = {};
+
+    // Maxima of (period - target) over consecutive blocks of blockCycles observations, for the extreme
+    // value fit in tailestimate.h.
+    uint64_t blockCycles = 0;
+    uint64_t blocks = 0;
+    double blockMaxSum = 0;         // nanoseconds
+    double blockMaxSumSquares = 0;  // nanoseconds squared
+
+    // Page faults incurred by the measuring thread after warm-up, set once measurement ends
+    bool pageFaultsMeasured = false;
+    uint64_t minorPageFaults = 0;
+    uint64_t majorPageFaults = 0;
+
+    // Set for OverheadReport rows, which hold instrumentation durations rather than periods
+    bool isOverhead = false;
+    // Set for OverheadReport rows that time one phase of the cycle rather than the instrumentation
+    bool isPhase = false;
   };
 
+  // The upload of a report is rewritten by its RT thread on every observation while the live table and the
+  // checkpoints read it, so it is published under a sequence lock. Only the one writer may publish;
+  // ReadReportData() retries until its copy overlapped no write.
+  void PublishReportData(ReportData& upload, const ReportData& data) noexcept;
+  ReportData ReadReportData(const ReportData& upload) noexcept;
+
   struct TableColumn
   {
     std::string Label;
@@ -111,6 +146,8 @@ namespace Evaluator
     int PrintLabels(std::ostream& stream) const;
     int PrintRow(std::string_view rowLabel, ReportData& data, std::ostream& stream) const;
     void PrintMaxLatencySummary(std::ostream& stream, std::string_view label, const ReportData& data) const;
+    int PrintPageFaultSummary(std::ostream& stream, std::string_view label, const ReportData& data) const;
+    int PrintOverheadSummary(std::ostream& stream, std::string_view label, const ReportData& data) const;
   private:
     std::vector<TableColumn> columns;
     int rowLabelWidth = DefaultRowLabelWidth;
@@ -126,10 +163,22 @@ namespace Evaluator
     TimerReport(uint64_t argTarget, uint64_t argBucketWidth, ReportData* argUpload = nullptr);
     void AddObservation(uint64_t observation, int index);
 
+    // Also estimate the 99th percentile. Off by default to keep a second estimator out of the RT loop.
+    void TrackP99();
+
     void PrintReport(bool isVerbose = false, std::ostream& stream = std::cout) const;
 
     ReportData Snapshot() const;
 
+    // Record the page faults incurred by the measuring thread during the measurement window
+    void SetPageFaults(uint64_t minorFaults, uint64_t majorFaults);
+
+    // Continue from the statistics of an earlier run (e.g. a checkpoint). Counts, extremes, buckets and
+    // block maxima are merged exactly; the median is approximated by weighting both medians by their
+    // observations. The p99 estimate only covers the new run, since checkpoints don't record it.
+    // Cycle indices of the new run continue after the restored observations.
+    void Restore(const ReportData& data);
+
   private:
     uint64_t min = std::numeric_limits<uint64_t>::max();
     uint64_t max = 0;
@@ -138,12 +187,73 @@ namespace Evaluator
     int maxIndex = -1;
     uint64_t observations = 0;
     QuantileEstimator median{0.50};
+    std::optional<QuantileEstimator> p99;
     ReportData* uploadLocation = nullptr;
     uint64_t target = 0;
     uint64_t bucketWidth = 0;
     uint64_t buckets[BucketCount] = {};
+    uint64_t blockCycles = 0;
+    uint64_t blockFill = 0;
+    uint64_t blockMax = 0;
+    uint64_t blocks = 0;
+    double blockMaxSum = 0;
+    double blockMaxSumSquares = 0;
+    bool pageFaultsMeasured = false;
+    uint64_t minorPageFaults = 0;
+    uint64_t majorPageFaults = 0;
+    ReportData restored;
+    int indexOffset = 0;
   };
 
+  // Time spent by the tool itself in each measured cycle (clock reads, AddObservation and the snapshot
+  // upload). Deliberately cheaper than TimerReport, with no quantile estimator, so it adds little of
+  // what it measures. Snapshots have a target of 0, so the buckets count overhead in bucket widths.
+  class OverheadReport
+  {
+  public:
+    OverheadReport(uint64_t argBucketWidth, ReportData* argUpload = nullptr, bool argIsPhase = false);
+    void AddObservation(uint64_t nanoseconds, int index);
+
+    // The median field holds the mean, since no quantile is tracked
+    ReportData Snapshot() const;
+
+  private:
+    uint64_t min = std::numeric_limits<uint64_t>::max();
+    uint64_t max = 0;
+    uint64_t sum = 0;
+    int minIndex = -1;
+    int maxIndex = -1;
+    uint64_t observations = 0;
+    uint64_t bucketWidth = 0;
+    uint64_t buckets[BucketCount] = {};
+    ReportData* uploadLocation = nullptr;
+    bool isPhase = false;
+  };
+
+  // Receiver-to-sender handoff latency in the NIC test: from the receiver's notify to the sender running
+  // again after blocking on the condition variable. Bins double in width like the latency categories:
+  // [0, 1us), [1us, 2us), [2us, 4us), ..., [512us, 1024us), >= 1024us.
+  inline constexpr size_t HandoffBinCount = 12;
+  inline constexpr uint64_t HandoffBinWidth = 1000;
+
+  struct HandoffHistogram
+  {
+    uint64_t bins[HandoffBinCount] = {};
+    uint64_t observations = 0;  // handoffs where the sender was blocked
+    uint64_t unblocked = 0;     // cycles where the receiver had signalled before the sender waited
+    uint64_t sum = 0;
+    uint64_t max = 0;
+    int maxIndex = -1;
+
+    void AddObservation(uint64_t nanoseconds, int index);
+  };
+
+  // One line per bin from the first to the last non-empty one, with a bar scaled to the largest bin
+  void PrintHandoffHistogram(std::ostream& stream, std::string_view label, const HandoffHistogram& data);
+
+  // Instrumentation taking more than this fraction of a bucket width on average distorts the categories
+  inline constexpr double OverheadWarningFraction = 0.1;
+
   inline uint64_t ToEpoch(const timespec& time)
   {
     return static_cast<uint64_t>(time.tv_sec) * NanoPerSec + static_cast<uint64_t>(time.tv_nsec);
@@ -156,14 +266,17 @@ namespace Evaluator
     return ToEpoch(current);
   }
 
+  // Adds the time until the end of the scope to a TimerReport or OverheadReport. The clock is only read
+  // if `recordTime` is set on entry.
+  template <class Report>
   class ScopedTimer
   {
   public:
-    ScopedTimer(TimerReport& report,  bool& recordTime, int index, const int clockId = CLOCK_MONOTONIC)
+    ScopedTimer(Report& report, bool recordTime, int index, const int clockId = CLOCK_MONOTONIC)
       : report(report)
       , recordTime(recordTime)
       , index(index)
-      , startTime(GetCurrentTime(clockId))
+      , startTime(recordTime ? GetCurrentTime(clockId) : 0)
       , clockId(clockId)
     {}
 
@@ -174,13 +287,49 @@ namespace Evaluator
     }
 
   private:
-    TimerReport& report;
-    bool& recordTime;
+    Report& report;
+    const bool recordTime;
     int index;
     uint64_t startTime;
     int clockId;
   };
 
+  // Pass/fail outcome of one run in a sweep or scenario
+  struct RunVerdict
+  {
+    std::string Label;
+    uint64_t Period = 0;       // target period in nanoseconds
+    uint64_t BucketWidth = 0;  // base bucket width in nanoseconds
+    uint64_t Observations = 0;
+    uint64_t MaxLatency = 0;   // worst (max - target) across all rows, in nanoseconds
+    uint64_t Overruns = 0;     // observations in the last bucket, i.e. a whole period late
+    uint64_t PageFaults = 0;   // minor + major page faults of the RT threads during measurement
+    bool Completed = false;    // false if the run stopped early because of an error
+
+    // A run passes when it ran to completion and its worst cycle is no worse than "Good"
+    static constexpr size_t PassBucketIndex = 1;
+    bool Passed() const;
+
+    // Fold one row of the run's final report into the verdict
+    void AddRow(const ReportData& data);
+  };
+
+  void PrintVerdictTable(std::ostream& stream, std::string_view title, const std::vector<RunVerdict>& results);
+  void PrintSweepVerdict(std::ostream& stream, const std::vector<RunVerdict>& results);
+
+  // Receive latency at one point of a NIC settings sweep, see --nic-sweep
+  struct NicSweepResult
+  {
+    std::string Setting;       // the swept values, e.g. "rx-usecs 0 rx-ring 256"
+    std::string Error;         // why the driver rejected the setting; empty if it was applied
+    uint64_t BucketWidth = 0;  // base bucket width in nanoseconds
+    uint64_t Observations = 0;
+    uint64_t P99Latency = 0;   // receive p99 - target, in nanoseconds
+    uint64_t MaxLatency = 0;   // receive max - target, in nanoseconds
+  };
+
+  void PrintNicSweepTable(std::ostream& stream, const std::vector<NicSweepResult>& results);
+
   int FormatDuration(std::chrono::milliseconds startTime, std::ostream& stream = std::cout);
   int FormatDuration(std::chrono::steady_clock::time_point startTime,
     std::chrono::steady_clock::time_point endTime, std::ostream& stream = std::cout);
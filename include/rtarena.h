@@ -0,0 +1,54 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_RTARENA_H
+#define RMP_EVAL_RTARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "numa.h"
+
+namespace Evaluator
+{
+  // Bump allocator over a region that is mapped, faulted in and locked up front, for anything an RT thread
+  // has to allocate inside its loop. It never calls malloc and never page-faults, so it is invisible to the
+  // allocation guard. Deallocation is a no-op; Reset() reclaims everything at once. Running out throws
+  // std::bad_alloc rather than falling back to the heap.
+  //
+  // An RtThread created with an ArenaSize owns one; code running on it reaches it through ForThisThread(), e.g.
+  //   std::pmr::vector<uint64_t> samples(count, RtArena::ForThisThread());
+  class RtArena final : public std::pmr::memory_resource
+  {
+  public:
+    // `node` is the NUMA node the region is bound to, or UnboundMemoryNode
+    explicit RtArena(size_t size, int node = UnboundMemoryNode);
+    ~RtArena() override;
+
+    // Disable copying
+    RtArena(const RtArena&) = delete;
+    // Disable copying
+    RtArena& operator=(const RtArena&) = delete;
+
+    void Reset() noexcept { used = 0; }
+    size_t Used() const noexcept { return used; }
+    size_t Capacity() const noexcept { return size; }
+
+    // The arena of the calling RtThread, or nullptr on any other thread
+    static RtArena* ForThisThread() noexcept;
+    static void SetForThisThread(RtArena* arena) noexcept;
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    char* base = nullptr;
+    size_t size = 0;
+    size_t used = 0;
+  };
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_RTARENA_H)
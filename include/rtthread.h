@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_RTTHREAD_H
+#define RMP_EVAL_RTTHREAD_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <pthread.h>
+#include <sched.h>
+
+#include "rtarena.h"
+
+namespace Evaluator
+{
+  inline constexpr size_t DefaultRtStackSize = 1 << 20; // 1MB, prefaulted and locked before the thread starts
+
+  struct RtThreadAttributes
+  {
+    int Policy = SCHED_FIFO;  // SCHED_OTHER creates the thread unprivileged, e.g. so it can switch to SCHED_DEADLINE itself
+    int Priority = 0;
+    int Cpu = 0;
+    size_t StackSize = DefaultRtStackSize;
+    size_t ArenaSize = 0;                  // bytes of the thread's RtArena, 0 for none
+    int MemoryNode = LocalMemoryNode;      // NUMA node of the stack, arena and the thread's own allocations
+  };
+
+  // A thread whose scheduling policy, priority and affinity are applied by pthread_create() itself
+  // (PTHREAD_EXPLICIT_SCHED) rather than after it starts running, and whose stack is allocated and
+  // faulted in up front so that the first touch of a stack page never page-faults on the RT path.
+  // With an ArenaSize the thread also gets its own RtArena, installed before the body runs. The stack, the arena and any page
+  // the thread faults in itself are placed on the NUMA node of its CPU unless MemoryNode says otherwise.
+  // Its timer slack is lowered to RtTimerSlackNanoseconds before the body runs.
+  class RtThread
+  {
+  public:
+    RtThread(const RtThreadAttributes& attributes, std::function<void()> body);
+    ~RtThread();
+
+    // Disable copying and moving; the running thread refers to this object
+    RtThread(const RtThread&) = delete;
+    RtThread& operator=(const RtThread&) = delete;
+
+    void Join();
+
+  private:
+    static void* Run(void* argument);
+
+    pthread_t thread = {};
+    bool joinable = false;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    std::function<void()> body;
+    std::unique_ptr<RtArena> arena;
+    int memoryNode = UnboundMemoryNode;
+  };
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_RTTHREAD_H)
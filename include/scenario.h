@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_SCENARIO_H
+#define RMP_EVAL_SCENARIO_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace Evaluator
+{
+  // One phase of a multi-phase test plan. Unset fields keep the value given on the command line.
+  //
+  // Scenario files are a small INI subset. Each [section] is a phase, run in file order; keys before
+  // the first section are defaults for every phase. Lines starting with '#' or ';' are comments.
+  //
+  //   nic = none
+  //   cpu = 3
+  //
+  //   [idle]
+  //   duration = 5m
+  //
+  //   [load]
+  //   duration = 30m
+  //   load = stress-ng --cpu 4 --vm 2
+  //
+  //   [nic traffic]
+  //   duration = 10m
+  //   nic = enp2s0
+  //
+  // Keys: duration (s, m or h suffix; required), period (us), cpu, send-cpu, receive-cpu,
+  //       nic ("none" for cyclic only), load (shell command run for the phase), warmup (ms),
+  //       scheduler (fifo or deadline), timer (nanosleep, timerfd, posix or spin)
+  struct ScenarioPhase
+  {
+    std::string Name;
+    uint64_t DurationSeconds = 0;
+    std::optional<uint64_t> PeriodMicroseconds;
+    std::optional<int> SendCpu;
+    std::optional<int> ReceiveCpu;
+    std::optional<std::string> NicName;
+    std::optional<std::string> Load;
+    std::optional<uint64_t> WarmupMilliseconds;
+    std::optional<std::string> Scheduler;
+    std::optional<std::string> Timer;
+  };
+
+  // Throws std::runtime_error naming the file and line of the first problem
+  std::vector<ScenarioPhase> LoadScenario(const std::string& path);
+
+  // A shell command run in its own process group for the lifetime of this object
+  class BackgroundLoad
+  {
+  public:
+    explicit BackgroundLoad(const std::string& command);
+    ~BackgroundLoad();
+
+    // Disable copying
+    BackgroundLoad(const BackgroundLoad&) = delete;
+    // Disable copying
+    BackgroundLoad& operator=(const BackgroundLoad&) = delete;
+
+  private:
+    pid_t pid = -1;
+  };
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_SCENARIO_H)
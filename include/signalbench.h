@@ -0,0 +1,69 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_SIGNALBENCH_H
+#define RMP_EVAL_SIGNALBENCH_H
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "reporter.h"
+
+namespace Evaluator
+{
+  inline constexpr uint64_t DefaultSignalWakeups = 2000;
+
+  // How one thread wakes a thread blocked on another core, see --signal-bench
+  enum class SignalMechanism
+  {
+    Futex,   // FUTEX_WAKE on a counter the waiter blocks on with FUTEX_WAIT, as under a condition variable
+    Eventfd, // write() to an eventfd the waiter blocks on in read()
+    Pipe,    // one byte through a pipe the waiter blocks on in read()
+  };
+
+  inline constexpr SignalMechanism AllSignalMechanisms[] =
+  {
+    SignalMechanism::Futex, SignalMechanism::Eventfd, SignalMechanism::Pipe
+  };
+
+  const char* GetSignalMechanismName(SignalMechanism mechanism);
+  std::optional<SignalMechanism> ParseSignalMechanism(std::string_view name);
+
+  class ISignal
+  {
+  public:
+    virtual ~ISignal() {}
+
+    // Wake the waiter; signals sent while it is running are not lost
+    virtual void Signal() = 0;
+
+    // Block until the next Signal()
+    virtual void Wait() = 0;
+  };
+
+  // Throws std::runtime_error if the kernel objects can't be created
+  std::unique_ptr<ISignal> CreateSignal(SignalMechanism mechanism);
+
+  struct SignalBenchResult
+  {
+    SignalMechanism Mechanism = SignalMechanism::Futex;
+    int FromCpu = -1;
+    int ToCpu = -1;
+    std::string Error;          // why the pair could not be measured; empty on success
+    HandoffHistogram Latency;   // from just before Signal() to the waiter running again
+  };
+
+  // A SCHED_FIFO RtThread on `fromCpu` signals a SCHED_FIFO RtThread blocked on `toCpu` once every
+  // `intervalNanoseconds`, so that the waiter is asleep again by the next signal, and the waiter records
+  // each wake latency after a short warm-up. A signal is only sent once the waiter has timed the previous
+  // one; intervals it is still late for are skipped, so a late wake counts in full.
+  SignalBenchResult MeasureSignalLatency(SignalMechanism mechanism, int fromCpu, int fromPriority,
+    int toCpu, int toPriority, uint64_t intervalNanoseconds, uint64_t wakeups);
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_SIGNALBENCH_H)
@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_TAILESTIMATE_H
+#define RMP_EVAL_TAILESTIMATE_H
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "reporter.h"
+
+namespace Evaluator
+{
+  // Fewer block maxima than this give confidence intervals too wide to be useful
+  inline constexpr uint64_t MinimumTailBlocks = 10;
+
+  // Gumbel distribution of the per-block maximum latency, fitted by the method of moments to the block
+  // maxima a TimerReport keeps. Block maxima are enough to extrapolate the tail without storing samples.
+  struct GumbelFit
+  {
+    uint64_t Blocks = 0;
+    double BlockSeconds = 0;  // duration of one block
+    double Mean = 0;          // of the block maxima, nanoseconds
+    double StdDev = 0;        // of the block maxima, nanoseconds
+    double Location = 0;      // mu, nanoseconds
+    double Scale = 0;         // beta, nanoseconds
+  };
+
+  // Empty if `data` holds fewer than MinimumTailBlocks blocks
+  std::optional<GumbelFit> FitGumbel(const ReportData& data);
+
+  // Chance that a block's maximum latency reaches `threshold`, with a 95% confidence interval from the
+  // standard error of the method-of-moments quantile, and the mean time between such blocks
+  struct ExceedanceEstimate
+  {
+    uint64_t Threshold = 0;   // latency (period - target) in nanoseconds
+    double Probability = 0;   // per block
+    double ProbabilityLow = 0;
+    double ProbabilityHigh = 0;
+    double SecondsBetween = 0; // BlockSeconds / Probability, infinite if the probability is 0
+    double SecondsBetweenLow = 0;
+    double SecondsBetweenHigh = 0;
+  };
+
+  ExceedanceEstimate EstimateExceedance(const GumbelFit& fit, uint64_t threshold);
+
+  // "4.2 s", "3.1 h", "12 days", "> 1000 years"
+  std::string DescribeInterval(double seconds);
+
+  // Exceedance estimate for the lower bound of each category above "Great", printed after the final table
+  void PrintTailEstimate(std::ostream& stream, std::string_view label, const ReportData& data);
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_TAILESTIMATE_H)
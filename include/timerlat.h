@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_TIMERLAT_H
+#define RMP_EVAL_TIMERLAT_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "reporter.h"
+
+namespace Evaluator
+{
+  // Where the kernel's timerlat tracer took a sample: in the timer interrupt, or in its own
+  // per-CPU kernel thread once that was scheduled
+  enum class TimerlatContext
+  {
+    Irq,
+    Thread,
+  };
+
+  struct TimerlatSample
+  {
+    TimerlatContext Context = TimerlatContext::Irq;
+    uint64_t Sequence = 0;    // activation number, the same for the IRQ and thread sample of one period
+    uint64_t Nanoseconds = 0; // from the timer's expiry to the sample
+  };
+
+  // One line of the timerlat trace, e.g. "timerlat/3-812 [003] ....... 92.31: #42 context thread timer_latency 2114 ns".
+  // Empty for any other line, including the user-space contexts of rtla.
+  std::optional<TimerlatSample> ParseTimerlatLine(std::string_view line);
+
+  // The kernel's timerlat tracer on one CPU with the same period as the RT threads, running alongside the
+  // user-space test (see --timerlat). It arms a timer each period and records how late the timer interrupt
+  // and then the timerlat kernel thread ran, measured in the kernel. Set up in a private tracefs instance;
+  // a non-RT thread reads the instance's trace_pipe into two duration rows for the live table. The osnoise
+  // settings it changes are restored by the destructor.
+  class TimerlatTracer
+  {
+  public:
+    // The first `warmupSamples` samples of each context are dropped, like the RT threads' warm-up.
+    // Throws std::runtime_error if tracefs is not mounted or the kernel has no timerlat tracer.
+    TimerlatTracer(int cpu, uint64_t period, uint64_t bucketWidth, uint64_t warmupSamples,
+      ReportData* irqData, ReportData* threadData);
+    ~TimerlatTracer();
+
+    // Disable copying
+    TimerlatTracer(const TimerlatTracer&) = delete;
+    // Disable copying
+    TimerlatTracer& operator=(const TimerlatTracer&) = delete;
+
+  private:
+    void Read(std::stop_token stopToken);
+    void Remove() noexcept;
+
+    std::string instance; // path of the tracefs instance
+    std::string osnoise;  // path of the global osnoise settings
+    std::string originalCpus;
+    std::string originalPeriod;
+    uint64_t warmupSamples = 0;
+    uint64_t irqSamples = 0;
+    uint64_t threadSamples = 0;
+    OverheadReport irqReport;
+    OverheadReport threadReport;
+    int pipeFd = -1;
+    std::jthread reader;
+  };
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_TIMERLAT_H)
@@ -0,0 +1,51 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_TIMING_H
+#define RMP_EVAL_TIMING_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <time.h>
+#include <vector>
+
+namespace Evaluator
+{
+  // Timer slack the RT threads run with. The kernel already ignores slack for SCHED_FIFO sleeps, but
+  // not for SCHED_DEADLINE/SCHED_OTHER threads or every wait path, and the default is 50us.
+  inline constexpr unsigned long RtTimerSlackNanoseconds = 1;
+
+  // A clock_gettime() slower than this is not served by the vDSO but falls back to a system call, e.g.
+  // because the clocksource is hpet or acpi_pm
+  inline constexpr double MaxVdsoClockReadNanoseconds = 150;
+
+  struct ClockReadCost
+  {
+    clockid_t Clock = CLOCK_MONOTONIC;
+    const char* Name = "";
+    uint64_t Resolution = 0;  // clock_getres() in nanoseconds, 0 if the clock is unsupported
+    double Nanoseconds = 0;   // mean cost of one clock_gettime() call
+  };
+
+  // Set the calling thread's timer slack to RtTimerSlackNanoseconds. Throws std::runtime_error on failure.
+  void SetRtTimerSlack();
+
+  // The calling thread's timer slack in nanoseconds, from PR_GET_TIMERSLACK
+  unsigned long GetTimerSlack();
+
+  // Resolution and per-call cost of each clock the tool or RMP may read, measured on `cpu` if given. The
+  // calling thread is moved to `cpu` for the measurement and back afterward.
+  std::vector<ClockReadCost> MeasureClockReadCosts(std::optional<int> cpu = std::nullopt);
+
+  // "MONOTONIC 21ns, REALTIME 22ns, ..."
+  std::string DescribeClockReadCosts(const std::vector<ClockReadCost>& costs);
+
+  // CONFIG_<option> from the running kernel's /boot/config-<release>, e.g. "1000" for HZ
+  std::optional<std::string> ParseKernelConfigOption(std::string_view config, std::string_view option);
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_TIMING_H)
@@ -0,0 +1,46 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_WAKETIMER_H
+#define RMP_EVAL_WAKETIMER_H
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <time.h>
+
+namespace Evaluator
+{
+  // The primitive used by the cyclic thread to sleep until its next period
+  enum class WakeMechanism
+  {
+    Nanosleep,  // clock_nanosleep(TIMER_ABSTIME)
+    Timerfd,    // timerfd armed with an absolute expiry and waited on with epoll
+    PosixTimer, // timer_create() delivering a realtime signal to the thread, waited on with sigwaitinfo()
+    Spin,       // busy-wait on clock_gettime()
+  };
+
+  inline constexpr WakeMechanism AllWakeMechanisms[] =
+  {
+    WakeMechanism::Nanosleep, WakeMechanism::Timerfd, WakeMechanism::PosixTimer, WakeMechanism::Spin
+  };
+
+  const char* GetWakeMechanismName(WakeMechanism mechanism);
+  std::optional<WakeMechanism> ParseWakeMechanism(std::string_view name);
+
+  class IWakeTimer
+  {
+  public:
+    virtual ~IWakeTimer() {}
+
+    // Block until CLOCK_MONOTONIC reaches the absolute time `next`
+    virtual void WaitUntil(const timespec& next) = 0;
+  };
+
+  // Must be called from the thread that will wait on the timer (POSIX timers signal the creating thread).
+  std::unique_ptr<IWakeTimer> CreateWakeTimer(WakeMechanism mechanism);
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_WAKETIMER_H)
@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#pragma once
+
+#ifndef RMP_EVAL_WORKERPROCESS_H
+#define RMP_EVAL_WORKERPROCESS_H
+
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <sys/types.h>
+
+#include "nictest.h"
+#include "reporter.h"
+
+namespace Evaluator
+{
+  const char* GetWorkerIsolationName(WorkerIsolation isolation);
+  std::optional<WorkerIsolation> ParseWorkerIsolation(std::string_view name);
+
+  // Body of the RT part of a run: starts the RT threads for `params` and blocks until they finish
+  using WorkerFunction = std::function<void(const TestParameters& params, ReportData& hardwareData, ReportData& softwareData)>;
+
+  // Runs a WorkerFunction in a forked child process. The child has its own address space (its own page
+  // tables, mmap lock and allocator), so display, config checks and checkpoints in the parent can't stall
+  // the RT threads through them. The only thing shared is one anonymous mapping that the child's
+  // TimerReports upload their snapshots into, plus the event log.
+  //
+  // Must be created while the calling process is single threaded, i.e. before the report and
+  // housekeeping threads are started, so that no lock is held by a thread that doesn't exist in the child.
+  class WorkerProcess
+  {
+  public:
+    // `running` is the flag the worker threads poll; in the child it is cleared when the parent asks to stop
+    WorkerProcess(const TestParameters& params, const WorkerFunction& work, std::atomic_bool& running);
+    ~WorkerProcess();
+
+    // Disable copying
+    WorkerProcess(const WorkerProcess&) = delete;
+    // Disable copying
+    WorkerProcess& operator=(const WorkerProcess&) = delete;
+
+    // `params` with the result pointers referring to the shared statistics
+    const TestParameters& Parameters() const { return workerParams; }
+    ReportData& HardwareData() { return shared->Hardware; }
+    ReportData& SoftwareData() { return shared->Software; }
+
+    // Block until the child exits, forwarding `running` going false as a stop request.
+    // Throws std::runtime_error if the child failed; its errors are in the event log.
+    void Wait(const std::atomic_bool& running);
+
+    // Copy the final statistics into the result locations of the original parameters
+    void CopyResults(const TestParameters& params, ReportData& hardwareData, ReportData& softwareData) const;
+
+  private:
+    struct SharedStatistics
+    {
+      ReportData Send;
+      ReportData Receive;
+      ReportData Hardware;
+      ReportData Software;
+      ReportData SendOverhead;
+      ReportData ReceiveOverhead;
+      HandoffHistogram Handoff;
+      ReportData Phases[CyclePhaseCount];
+      std::atomic_bool StopRequested = false;
+    };
+
+    [[noreturn]] void RunChild(const WorkerFunction& work, std::atomic_bool& running);
+
+    SharedStatistics* shared = nullptr;
+    TestParameters workerParams;
+    pid_t pid = -1;
+  };
+} // end namespace Evaluator
+
+#endif // !defined(RMP_EVAL_WORKERPROCESS_H)
@@ -0,0 +1,203 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <unistd.h>
+
+#include "allocationguard.h"
+#include "eventlog.h"
+
+namespace Evaluator
+{
+  static constexpr int MaxRecordedSites = 8;
+  static constexpr int MaxFrames = 12;
+  static constexpr int GuardFrames = 2; // OnAllocation() and the interposed function
+
+  struct AllocationSite
+  {
+    size_t Size = 0;
+    int FrameCount = 0;
+    void* Frames[MaxFrames] = {};
+  };
+
+  // Everything is thread_local and fixed-size so that recording an allocation does not allocate
+  struct ThreadGuardState
+  {
+    int SectionDepth = 0;
+    bool InHook = false;
+    uint64_t Count = 0;
+    uint64_t CountAtSectionStart = 0;
+    int SiteCount = 0;
+    AllocationSite Sites[MaxRecordedSites];
+  };
+
+  static thread_local ThreadGuardState guardState;
+  static std::atomic<AllocationGuardMode> guardMode = AllocationGuardMode::Off;
+
+  const char* GetAllocationGuardModeName(AllocationGuardMode mode)
+  {
+    switch (mode)
+    {
+      case AllocationGuardMode::Off: return "off";
+      case AllocationGuardMode::Count: return "count";
+      case AllocationGuardMode::Trap: return "trap";
+    }
+    return "unknown";
+  }
+
+  std::optional<AllocationGuardMode> ParseAllocationGuardMode(std::string_view name)
+  {
+    for (AllocationGuardMode mode : { AllocationGuardMode::Off, AllocationGuardMode::Count, AllocationGuardMode::Trap })
+    {
+      if (name == GetAllocationGuardModeName(mode)) { return mode; }
+    }
+    return std::nullopt;
+  }
+
+  bool IsAllocationGuardAvailable()
+  {
+#if defined(RMP_EVAL_ALLOCATION_GUARD)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void SetAllocationGuardMode(AllocationGuardMode mode)
+  {
+    // The first backtrace() loads libgcc_s, which allocates; do it now rather than inside a section
+    void* frames[1];
+    backtrace(frames, 1);
+    guardMode.store(mode, std::memory_order_release);
+  }
+
+  void OnAllocation(size_t size) noexcept
+  {
+    ThreadGuardState& state = guardState;
+    if (state.SectionDepth == 0 || state.InHook)
+    {
+      return;
+    }
+    const AllocationGuardMode mode = guardMode.load(std::memory_order_relaxed);
+    if (mode == AllocationGuardMode::Off)
+    {
+      return;
+    }
+
+    state.InHook = true;
+    ++state.Count;
+    if (mode == AllocationGuardMode::Trap)
+    {
+      char message[96];
+      int length = std::snprintf(message, sizeof(message), "rmp-eval: %zu byte allocation inside an RT section:\n", size);
+      if (write(STDERR_FILENO, message, static_cast<size_t>(length)) < 0) {}
+      void* frames[MaxFrames * 2];
+      backtrace_symbols_fd(frames, backtrace(frames, MaxFrames * 2), STDERR_FILENO);
+      std::abort();
+    }
+    if (state.SiteCount < MaxRecordedSites)
+    {
+      AllocationSite& site = state.Sites[state.SiteCount++];
+      site.Size = size;
+      site.FrameCount = backtrace(site.Frames, MaxFrames);
+    }
+    state.InHook = false;
+  }
+
+  static bool IsStandardLibrarySymbol(const char* name)
+  {
+    return name != nullptr && (std::strncmp(name, "_ZSt", 4) == 0 || std::strncmp(name, "_ZNSt", 5) == 0
+      || std::strncmp(name, "_ZNKSt", 6) == 0);
+  }
+
+  // Name the frame that allocated: the first one in the main executable outside the guard itself and
+  // outside std:: template code instantiated there. Runs after the section has ended, so it may allocate.
+  static void DescribeSite(const AllocationSite& site, char* buffer, size_t bufferSize)
+  {
+    Dl_info self = {};
+    dladdr(reinterpret_cast<void*>(&OnAllocation), &self);
+
+    void* caller = nullptr;
+    Dl_info callerInfo = {};
+    for (int frame = GuardFrames; frame < site.FrameCount; ++frame)
+    {
+      Dl_info info = {};
+      if (dladdr(site.Frames[frame], &info) == 0 || info.dli_fbase != self.dli_fbase)
+      {
+        continue;
+      }
+      if (caller == nullptr || IsStandardLibrarySymbol(callerInfo.dli_sname))
+      {
+        caller = site.Frames[frame];
+        callerInfo = info;
+      }
+      if (!IsStandardLibrarySymbol(info.dli_sname))
+      {
+        break;
+      }
+    }
+
+    if (caller == nullptr)
+    {
+      std::snprintf(buffer, bufferSize, "%zu bytes from an unknown caller", site.Size);
+    }
+    else if (callerInfo.dli_sname != nullptr)
+    {
+      int status = -1;
+      char* demangled = abi::__cxa_demangle(callerInfo.dli_sname, nullptr, nullptr, &status);
+      std::snprintf(buffer, bufferSize, "%zu bytes from %s+0x%tx", site.Size, status == 0 ? demangled : callerInfo.dli_sname,
+        static_cast<char*>(caller) - static_cast<char*>(callerInfo.dli_saddr));
+      std::free(demangled);
+    }
+    else
+    {
+      std::snprintf(buffer, bufferSize, "%zu bytes from +0x%tx (resolve with addr2line)", site.Size,
+        static_cast<char*>(caller) - static_cast<char*>(callerInfo.dli_fbase));
+    }
+  }
+
+  RtSection::RtSection(std::string_view argSource) noexcept
+    : source(argSource)
+  {
+    ThreadGuardState& state = guardState;
+    if (state.SectionDepth++ == 0)
+    {
+      state.CountAtSectionStart = state.Count;
+      state.SiteCount = 0;
+    }
+  }
+
+  RtSection::~RtSection()
+  {
+    ThreadGuardState& state = guardState;
+    if (--state.SectionDepth != 0)
+    {
+      return;
+    }
+
+    const uint64_t caught = state.Count - state.CountAtSectionStart;
+    if (caught == 0)
+    {
+      return;
+    }
+    char message[Event::MessageSize];
+    std::snprintf(message, sizeof(message), "%lu heap allocations inside the RT loop", static_cast<unsigned long>(caught));
+    GetEventLog().Post(EventLevel::Error, source, message);
+    for (int index = 0; index < state.SiteCount; ++index)
+    {
+      DescribeSite(state.Sites[index], message, sizeof(message));
+      GetEventLog().Post(EventLevel::Error, source, message);
+    }
+  }
+
+  uint64_t GetRtAllocationCount()
+  {
+    return guardState.Count;
+  }
+} // end namespace Evaluator
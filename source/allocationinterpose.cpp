@@ -0,0 +1,86 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+// Linked into the executables only when configured with -DRMP_EVAL_ALLOCATION_GUARD=ON. Definitions in
+// the executable take precedence over glibc's, so every allocation in the process, including those made
+// by libstdc++, passes through here before being served by glibc's allocator.
+
+#include <cerrno>
+#include <cstddef>
+#include <new>
+
+#include "allocationguard.h"
+
+extern "C"
+{
+  void* __libc_malloc(size_t size);
+  void* __libc_calloc(size_t count, size_t size);
+  void* __libc_realloc(void* pointer, size_t size);
+  void* __libc_memalign(size_t alignment, size_t size);
+  void __libc_free(void* pointer);
+
+  void* malloc(size_t size)
+  {
+    Evaluator::OnAllocation(size);
+    return __libc_malloc(size);
+  }
+
+  void* calloc(size_t count, size_t size)
+  {
+    Evaluator::OnAllocation(count * size);
+    return __libc_calloc(count, size);
+  }
+
+  void* realloc(void* pointer, size_t size)
+  {
+    Evaluator::OnAllocation(size);
+    return __libc_realloc(pointer, size);
+  }
+
+  void* aligned_alloc(size_t alignment, size_t size)
+  {
+    Evaluator::OnAllocation(size);
+    return __libc_memalign(alignment, size);
+  }
+
+  void* memalign(size_t alignment, size_t size)
+  {
+    Evaluator::OnAllocation(size);
+    return __libc_memalign(alignment, size);
+  }
+
+  int posix_memalign(void** pointer, size_t alignment, size_t size)
+  {
+    Evaluator::OnAllocation(size);
+    void* result = __libc_memalign(alignment, size);
+    if (result == nullptr) { return ENOMEM; }
+    *pointer = result;
+    return 0;
+  }
+
+  void free(void* pointer)
+  {
+    __libc_free(pointer);
+  }
+}
+
+// operator new would reach malloc() anyway, but catching it here keeps the frame that called new one
+// step closer to the top of the recorded backtrace
+void* operator new(size_t size)
+{
+  Evaluator::OnAllocation(size);
+  if (void* pointer = __libc_malloc(size)) { return pointer; }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+  Evaluator::OnAllocation(size);
+  if (void* pointer = __libc_malloc(size)) { return pointer; }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { __libc_free(pointer); }
+void operator delete[](void* pointer) noexcept { __libc_free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { __libc_free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { __libc_free(pointer); }
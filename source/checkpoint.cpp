@@ -0,0 +1,125 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "checkpoint.h"
+#include "nictest.h"
+
+namespace Evaluator
+{
+  static constexpr char CheckpointMagic[] = "rmp-eval-checkpoint";
+  static constexpr int CheckpointVersion = 2;
+
+  const ReportData* Checkpoint::Find(std::string_view label) const
+  {
+    for (const auto& [rowLabel, data] : Rows)
+    {
+      if (rowLabel == label) { return &data; }
+    }
+    return nullptr;
+  }
+
+  // Text format, one record per line:
+  //   rmp-eval-checkpoint 2
+  //   period <ns> <bucket width ns>
+  //   row <observations> <min> <max> <sum> <minIndex> <maxIndex> <median> <target> <minor faults> <major faults>
+  //       <blocks> <block max sum> <block max sum of squares> <buckets...> <label>
+  void SaveCheckpoint(const std::string& path, const Checkpoint& checkpoint)
+  {
+    std::ostringstream stream;
+    stream.precision(17);
+    stream << CheckpointMagic << " " << CheckpointVersion << "\n";
+    stream << "period " << checkpoint.Period << " " << checkpoint.BucketWidth << "\n";
+    for (const auto& [label, data] : checkpoint.Rows)
+    {
+      stream << "row " << data.observations << " " << data.min << " " << data.max << " " << data.sum << " "
+             << data.minIndex << " " << data.maxIndex << " " << data.median << " " << data.target << " "
+             << data.minorPageFaults << " " << data.majorPageFaults << " "
+             << data.blocks << " " << data.blockMaxSum << " " << data.blockMaxSumSquares;
+      for (uint64_t bucket : data.buckets)
+      {
+        stream << " " << bucket;
+      }
+      stream << " " << label << "\n";
+    }
+    const std::string contents = stream.str();
+
+    const std::string temporaryPath = path + ".tmp";
+    int fileDescriptor = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fileDescriptor < 0)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to open checkpoint file " + temporaryPath));
+    }
+    bool written = write(fileDescriptor, contents.data(), contents.size()) == static_cast<ssize_t>(contents.size());
+    written = (fsync(fileDescriptor) == 0) && written;
+    close(fileDescriptor);
+    if (!written || std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to write checkpoint file " + path));
+    }
+  }
+
+  Checkpoint LoadCheckpoint(const std::string& path)
+  {
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to open checkpoint file " + path));
+    }
+
+    auto fail = [&path](const std::string& message)
+    {
+      throw std::runtime_error("Invalid checkpoint file " + path + ": " + message);
+    };
+
+    std::string magic;
+    int version = 0;
+    if (!(file >> magic >> version) || magic != CheckpointMagic) { fail("missing header"); }
+    if (version != CheckpointVersion) { fail("unsupported version " + std::to_string(version)); }
+
+    Checkpoint checkpoint;
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line))
+    {
+      if (line.empty()) { continue; }
+      std::istringstream stream(line);
+      std::string record;
+      stream >> record;
+      if (record == "period")
+      {
+        if (!(stream >> checkpoint.Period >> checkpoint.BucketWidth)) { fail("bad period record"); }
+      }
+      else if (record == "row")
+      {
+        ReportData data;
+        stream >> data.observations >> data.min >> data.max >> data.sum >> data.minIndex >> data.maxIndex
+               >> data.median >> data.target >> data.minorPageFaults >> data.majorPageFaults
+               >> data.blocks >> data.blockMaxSum >> data.blockMaxSumSquares;
+        for (uint64_t& bucket : data.buckets)
+        {
+          stream >> bucket;
+        }
+        if (!stream) { fail("bad row record"); }
+        std::string label;
+        std::getline(stream >> std::ws, label);
+        if (label.empty()) { fail("row without a label"); }
+        data.bucketWidth = checkpoint.BucketWidth;
+        data.pageFaultsMeasured = true;
+        checkpoint.Rows.emplace_back(label, data);
+      }
+      else
+      {
+        fail("unknown record \"" + record + "\"");
+      }
+    }
+    if (checkpoint.Period == 0) { fail("no period record"); }
+    return checkpoint;
+  }
+} // end namespace Evaluator
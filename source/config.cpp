@@ -2,6 +2,9 @@
 // Licensed under the MIT License. See LICENSE file in the project root for details.
 
 #include "config.h"
+#include "ethtool.h"
+#include "nicthreads.h"
+#include "timing.h"
 
 #include <algorithm>
 #include <arpa/inet.h>
@@ -23,10 +26,12 @@
 #include <net/if.h>
 #include <netinet/in.h>
 #include <optional>
+#include <sched.h>
 #include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <sys/prctl.h>
 #include <sys/stat.h>
 #include <sys/utsname.h>
 #include <unistd.h>
@@ -1003,6 +1008,83 @@ namespace Evaluator
     }
   };
 
+  class HighResTimersCheck final : public ICheck
+  {
+  public:
+    CheckKind Kind() const noexcept override { return CheckKind::HighResTimers; }
+    const std::string& Name() const noexcept override { static const std::string k = "High-resolution timers"; return k; }
+    Domain GetDomain() const noexcept override { return Domain::System; }
+
+    [[nodiscard]] CheckResult Evaluate(const CheckContext&, const IDataSource& dataSource) const override
+    {
+      // Without hrtimers, clock_getres() reports the tick length and every sleep is rounded up to a tick
+      timespec resolution = {};
+      if (clock_getres(CLOCK_MONOTONIC, &resolution) != 0) return { Kind(), Status::Unknown, Name(), "clock_getres failed" };
+      const long nanoseconds = resolution.tv_sec * 1'000'000'000L + resolution.tv_nsec;
+      std::string detail = "resolution " + std::to_string(nanoseconds) + " ns";
+
+      struct utsname uname_info = {};
+      if (uname(&uname_info) == 0)
+      {
+        if (auto config = dataSource.Read(std::string("/boot/config-") + uname_info.release))
+        {
+          if (auto hz = ParseKernelConfigOption(*config, "HZ")) detail += ", CONFIG_HZ=" + *hz;
+          if (nanoseconds > 1)
+          {
+            detail += ", CONFIG_HIGH_RES_TIMERS=" + ParseKernelConfigOption(*config, "HIGH_RES_TIMERS").value_or("n");
+          }
+        }
+      }
+      return { Kind(), nanoseconds <= 1 ? Status::Pass : Status::Fail, Name(), detail };
+    }
+  };
+
+  class ClockReadCostCheck final : public ICheck
+  {
+  public:
+    CheckKind Kind() const noexcept override { return CheckKind::ClockReadCost; }
+    const std::string& Name() const noexcept override { static const std::string k = "Clock reads via vDSO"; return k; }
+    Domain GetDomain() const noexcept override { return Domain::Cpu; }
+
+    [[nodiscard]] CheckResult Evaluate(const CheckContext& checkContext, const IDataSource&) const override
+    {
+      // Measured rather than inferred from the clocksource name, since the vDSO fallback also depends on
+      // the kernel, the hypervisor and the TSC being marked stable
+      auto costs = MeasureClockReadCosts(checkContext.cpu);
+      auto monotonic = std::find_if(costs.begin(), costs.end(), [](const ClockReadCost& cost) { return cost.Clock == CLOCK_MONOTONIC; });
+      if (monotonic == costs.end() || monotonic->Resolution == 0) return { Kind(), Status::Unknown, Name(), "CLOCK_MONOTONIC unavailable" };
+      const bool fast = monotonic->Nanoseconds <= MaxVdsoClockReadNanoseconds;
+      return { Kind(), fast ? Status::Pass : Status::Fail, Name(), DescribeClockReadCosts(costs) + (fast ? "" : " (system call fallback?)") };
+    }
+  };
+
+  class TimerSlackCheck final : public ICheck
+  {
+  public:
+    CheckKind Kind() const noexcept override { return CheckKind::TimerSlack; }
+    const std::string& Name() const noexcept override { static const std::string k = "RT timer slack"; return k; }
+    Domain GetDomain() const noexcept override { return Domain::System; }
+
+    [[nodiscard]] CheckResult Evaluate(const CheckContext&, const IDataSource&) const override
+    {
+      // The RT threads inherit this thread's slack and lower it themselves; try that here and put it back
+      const unsigned long inherited = GetTimerSlack();
+      std::string detail = "inherited " + std::to_string(inherited) + " ns";
+      try
+      {
+        SetRtTimerSlack();
+      }
+      catch (const std::exception& error)
+      {
+        return { Kind(), Status::Fail, Name(), detail + ", " + error.what() };
+      }
+      const unsigned long applied = GetTimerSlack();
+      prctl(PR_SET_TIMERSLACK, inherited);
+      return { Kind(), applied == RtTimerSlackNanoseconds ? Status::Pass : Status::Fail, Name(),
+        detail + ", RT threads " + std::to_string(applied) + " ns" };
+    }
+  };
+
   class SmtSiblingIsolatedCheck final : public ICheck
   {
   public:
@@ -1031,6 +1113,120 @@ namespace Evaluator
     }
   };
 
+  class NicNumaLocalCheck final : public ICheck
+  {
+  public:
+    [[nodiscard]] CheckKind Kind() const noexcept override { return CheckKind::NicNumaLocal; }
+    [[nodiscard]] const std::string& Name() const noexcept override { static const std::string k = "NIC on RT core's NUMA node"; return k; }
+    [[nodiscard]] Domain GetDomain() const noexcept override { return Domain::Nic; }
+
+    [[nodiscard]] CheckResult Evaluate(const CheckContext& checkContext, const IDataSource& dataSource) const override
+    {
+      if (!checkContext.cpu) return { Kind(), Status::Unknown, Name(), "no CPU subject" };
+      const int cpu = *checkContext.cpu;
+      if (!checkContext.nic) return { Kind(), Status::Unknown, Name(), "no NIC in context" };
+      const std::string nic = *checkContext.nic;
+
+      auto online_value = dataSource.Read("/sys/devices/system/node/online");
+      if (!online_value) return { Kind(), Status::Pass, Name(), "kernel without NUMA" };
+      auto nodes = ParseCpuList(*online_value);
+      if (nodes.size() <= 1) return { Kind(), Status::Pass, Name(), "single NUMA node" };
+
+      auto nic_value = dataSource.Read(std::string("/sys/class/net/") + nic + "/device/numa_node");
+      if (!nic_value) return { Kind(), Status::Unknown, Name(), "no device/numa_node" };
+      int nic_node = -1;
+      try { nic_node = std::stoi(Trim(*nic_value)); } catch (...) {}
+      if (nic_node < 0) return { Kind(), Status::Unknown, Name(), "NIC reports no NUMA affinity" };
+
+      std::optional<int> cpu_node;
+      for (int node : nodes)
+      {
+        auto cpus_value = dataSource.Read(std::string("/sys/devices/system/node/node") + std::to_string(node) + "/cpulist");
+        if (cpus_value && ParseCpuList(*cpus_value).count(cpu)) { cpu_node = node; break; }
+      }
+      if (!cpu_node) return { Kind(), Status::Unknown, Name(), std::string("cannot find the node of CPU") + std::to_string(cpu) };
+
+      std::string placement = "NIC on node " + std::to_string(nic_node) + ", CPU" + std::to_string(cpu) + " on node " + std::to_string(*cpu_node);
+      if (nic_node != *cpu_node) return { Kind(), Status::Fail, Name(), placement + "; DMA and IRQs cross the interconnect" };
+      return { Kind(), Status::Pass, Name(), placement };
+    }
+  };
+
+  class NicCoalescingCheck final : public ICheck
+  {
+  public:
+    [[nodiscard]] CheckKind Kind() const noexcept override { return CheckKind::NicCoalescingOff; }
+    [[nodiscard]] const std::string& Name() const noexcept override { static const std::string k = "NIC RX coalescing off"; return k; }
+    [[nodiscard]] Domain GetDomain() const noexcept override { return Domain::Nic; }
+
+    [[nodiscard]] CheckResult Evaluate(const CheckContext& checkContext, const IDataSource& dataSource) const override
+    {
+      if (!checkContext.nic) return { Kind(), Status::Unknown, Name(), "no NIC in context" };
+      const std::string nic = *checkContext.nic;
+      if (!NicExists(dataSource, nic))
+      {
+        return { Kind(), Status::Unknown, Name(), "NIC not found" };
+      }
+      ethtool_coalesce settings = {};
+      try
+      {
+        settings = GetCoalescing(nic);
+      }
+      catch (const EthtoolError& error)
+      {
+        if (error.Error == EOPNOTSUPP) return { Kind(), Status::Unknown, Name(), "driver has no coalescing support" };
+        return { Kind(), Status::Unknown, Name(), std::string("ETHTOOL_GCOALESCE failed: ") + std::strerror(error.Error) };
+      }
+      catch (const std::runtime_error& error)
+      {
+        return { Kind(), Status::Unknown, Name(), error.what() };
+      }
+      std::ostringstream output_stream;
+      output_stream << "rx-usecs=" << settings.rx_coalesce_usecs << ", rx-frames=" << settings.rx_max_coalesced_frames
+                    << ", adaptive rx/tx=" << (settings.use_adaptive_rx_coalesce ? "on" : "off") << "/" << (settings.use_adaptive_tx_coalesce ? "on" : "off");
+      if (DelaysReceive(settings)) return { Kind(), Status::Fail, Name(), output_stream.str() + " (try --coalescing rt)" };
+      return { Kind(), Status::Pass, Name(), output_stream.str() };
+    }
+  };
+
+  class NicThreadPriorityCheck final : public ICheck
+  {
+  public:
+    [[nodiscard]] CheckKind Kind() const noexcept override { return CheckKind::NicThreadPriority; }
+    [[nodiscard]] const std::string& Name() const noexcept override { static const std::string k = "NIC IRQ/NAPI threads below RT"; return k; }
+    [[nodiscard]] Domain GetDomain() const noexcept override { return Domain::Nic; }
+
+    [[nodiscard]] CheckResult Evaluate(const CheckContext& checkContext, const IDataSource& dataSource) const override
+    {
+      if (!checkContext.nic) return { Kind(), Status::Unknown, Name(), "no NIC in context" };
+      const std::string nic = *checkContext.nic;
+      if (!NicExists(dataSource, nic))
+      {
+        return { Kind(), Status::Unknown, Name(), "NIC not found" };
+      }
+      auto threads = FindNicKernelThreads(nic);
+      if (threads.empty()) return { Kind(), Status::Unknown, Name(), "no IRQ/NAPI threads (IRQs not threaded?)" };
+
+      std::optional<int> lowest_rt;
+      if (checkContext.sendPriority && checkContext.receivePriority) lowest_rt = std::min(*checkContext.sendPriority, *checkContext.receivePriority);
+      std::ostringstream bad_stream;
+      int bad_count = 0;
+      for (const auto& thread : threads)
+      {
+        const bool is_rt = (thread.Policy == SCHED_FIFO || thread.Policy == SCHED_RR);
+        if (is_rt && (!lowest_rt || thread.Priority < *lowest_rt)) continue;
+        if (bad_count++ < MaxIrqsToShow) bad_stream << (bad_count > 1 ? ", " : "") << thread.Name << " " << DescribeSchedulingPolicy(thread.Policy, thread.Priority) << " on " << thread.Cpus;
+      }
+      if (bad_count == 0)
+      {
+        const auto& first = threads.front();
+        return { Kind(), Status::Pass, Name(), std::to_string(threads.size()) + " threads, e.g. " + first.Name + " " + DescribeSchedulingPolicy(first.Policy, first.Priority) + " on " + first.Cpus };
+      }
+      std::string limit = lowest_rt ? " (RT threads at " + std::to_string(*lowest_rt) + "+)" : "";
+      return { Kind(), Status::Fail, Name(), std::to_string(bad_count) + "/" + std::to_string(threads.size()) + limit + ": " + bad_stream.str() };
+    }
+  };
+
   // Helper functions for system info
 
   std::string GetCpuInfo()
@@ -1182,7 +1378,7 @@ namespace Evaluator
     return output.str();
   }
 
-  void ReportSystemConfiguration(int cpu, std::string_view nicName)
+  void ReportSystemConfiguration(int cpu, std::string_view nicName, std::optional<int> sendPriority, std::optional<int> receivePriority)
   {
     auto cpuCount = CpuCount();
     if (cpu < 0 || cpu >= cpuCount)
@@ -1204,6 +1400,8 @@ namespace Evaluator
     {
       checkContext.nic = std::string(nicName);
     }
+    checkContext.sendPriority = sendPriority;
+    checkContext.receivePriority = receivePriority;
     Evaluator::SystemFileSystemDataSource data;
 
     // System-wide checks
@@ -1213,6 +1411,8 @@ namespace Evaluator
     system_checks.emplace_back(std::make_unique<Evaluator::TimerMigrationCheck>());
     system_checks.emplace_back(std::make_unique<Evaluator::RtThrottlingCheck>());
     system_checks.emplace_back(std::make_unique<Evaluator::ClocksourceCheck>());
+    system_checks.emplace_back(std::make_unique<Evaluator::HighResTimersCheck>());
+    system_checks.emplace_back(std::make_unique<Evaluator::TimerSlackCheck>());
 
     for (const auto &check : system_checks)
     {
@@ -1233,6 +1433,7 @@ namespace Evaluator
     core_checks.emplace_back(std::make_unique<Evaluator::SmtSiblingIsolatedCheck>());
     core_checks.emplace_back(std::make_unique<Evaluator::CStatesCappedCheck>());
     core_checks.emplace_back(std::make_unique<Evaluator::TurboPolicyCheck>());
+    core_checks.emplace_back(std::make_unique<Evaluator::ClockReadCostCheck>());
 
     for (const auto &check : core_checks)
     {
@@ -1256,6 +1457,9 @@ namespace Evaluator
         nic_checks.emplace_back(std::make_unique<Evaluator::NicQuietCheck>());
         nic_checks.emplace_back(std::make_unique<Evaluator::NicIrqsPinnedCheck>());
         nic_checks.emplace_back(std::make_unique<Evaluator::RpsDisabledCheck>());
+        nic_checks.emplace_back(std::make_unique<Evaluator::NicNumaLocalCheck>());
+        nic_checks.emplace_back(std::make_unique<Evaluator::NicCoalescingCheck>());
+        nic_checks.emplace_back(std::make_unique<Evaluator::NicThreadPriorityCheck>());
         for (const auto &check : nic_checks)
         {
           auto result = check->Evaluate(checkContext, data);
@@ -0,0 +1,239 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <sys/mman.h>
+
+#include "cycletrace.h"
+#include "nictest.h"
+#include "numa.h"
+#include "reporter.h"
+
+namespace Evaluator
+{
+  static constexpr char CycleTraceMagic[] = "rmp-eval-cycles";
+  static constexpr int CycleTraceVersion = 1;
+
+  // Text format, one record per line:
+  //   rmp-eval-cycles 1
+  //   period <ns>
+  //   <lateness ns>        one line per cycle
+  //   dropped <cycles>     last line, written by Close()
+  CycleTrace::CycleTrace(const std::string& path, uint64_t period, size_t capacity)
+    : mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1), path(path)
+  {
+    static_assert(sizeof(Ring) % alignof(uint64_t) == 0);
+    mappingSize = sizeof(Ring) + (mask + 1) * sizeof(uint64_t);
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to allocate the cycle trace."));
+    }
+    ring = new (mapping) Ring();
+    slots = reinterpret_cast<uint64_t*>(static_cast<char*>(mapping) + sizeof(Ring));
+
+    file.open(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+      munmap(ring, mappingSize);
+      throw std::runtime_error(AppendErrorCode("Failed to open cycle trace file " + path));
+    }
+    file << CycleTraceMagic << " " << CycleTraceVersion << "\n" << "period " << period << "\n";
+  }
+
+  CycleTrace::~CycleTrace()
+  {
+    munmap(ring, mappingSize);
+  }
+
+  void CycleTrace::BindToNode(int node)
+  {
+    BindMemoryToNode(ring, mappingSize, node);
+  }
+
+  bool CycleTrace::Record(uint64_t lateness) noexcept
+  {
+    const uint64_t position = ring->WritePosition.load(std::memory_order_relaxed);
+    if (position - ring->ReadPosition.load(std::memory_order_acquire) > mask)
+    {
+      ring->Dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    slots[position & mask] = lateness;
+    ring->WritePosition.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t CycleTrace::Flush()
+  {
+    const uint64_t end = ring->WritePosition.load(std::memory_order_acquire);
+    uint64_t position = ring->ReadPosition.load(std::memory_order_relaxed);
+    const size_t count = end - position;
+    for (; position != end; ++position)
+    {
+      file << slots[position & mask] << "\n";
+    }
+    ring->ReadPosition.store(position, std::memory_order_release);
+    written += count;
+    return count;
+  }
+
+  void CycleTrace::Close()
+  {
+    if (!file.is_open()) { return; }
+    Flush();
+    file << "dropped " << Dropped() << "\n";
+    file.close();
+    if (file.fail())
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to write cycle trace file " + path));
+    }
+  }
+
+  CycleRecording LoadCycleRecording(const std::string& path)
+  {
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to open cycle trace file " + path));
+    }
+
+    auto fail = [&path](const std::string& message)
+    {
+      throw std::runtime_error("Invalid cycle trace file " + path + ": " + message);
+    };
+
+    std::string magic;
+    int version = 0;
+    if (!(file >> magic >> version) || magic != CycleTraceMagic) { fail("missing header"); }
+    if (version != CycleTraceVersion) { fail("unsupported version " + std::to_string(version)); }
+
+    CycleRecording recording;
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line))
+    {
+      if (line.empty()) { continue; }
+      std::istringstream stream(line);
+      if (line.front() >= '0' && line.front() <= '9')
+      {
+        uint64_t lateness = 0;
+        if (!(stream >> lateness)) { fail("bad cycle record"); }
+        recording.Lateness.push_back(lateness);
+        continue;
+      }
+      std::string record;
+      stream >> record;
+      if (record == "period")
+      {
+        if (!(stream >> recording.Period)) { fail("bad period record"); }
+      }
+      else if (record == "dropped")
+      {
+        if (!(stream >> recording.Dropped)) { fail("bad dropped record"); }
+      }
+      else
+      {
+        fail("unknown record \"" + record + "\"");
+      }
+    }
+    if (recording.Period == 0) { fail("no period record"); }
+    return recording;
+  }
+
+  bool ReplayResult::Passed() const
+  {
+    return Cycles > 0 && Misses == 0 && GetBucketIndex(MaxLatency, BucketWidth, BucketCount) <= RunVerdict::PassBucketIndex;
+  }
+
+  ReplayResult ReplayCycles(const std::vector<uint64_t>& lateness, uint64_t period, uint64_t budget)
+  {
+    ReplayResult result;
+    result.Period = period;
+    result.Budget = budget;
+    result.BucketWidth = period * 0.125;
+    result.Cycles = lateness.size();
+    if (lateness.empty()) { return result; }
+
+    uint64_t previousStart = 0;
+    uint64_t previousFinish = 0;
+    double slackSum = 0;
+    result.MinSlack = INT64_MAX;
+    for (uint64_t index = 0; index < lateness.size(); ++index)
+    {
+      const uint64_t release = index * period;
+      const uint64_t start = std::max(release + lateness[index], previousFinish);
+      const uint64_t finish = start + budget;
+      const int64_t slack = static_cast<int64_t>(release + period) - static_cast<int64_t>(finish);
+      if (slack < 0) { ++result.Misses; }
+      result.MinSlack = std::min(result.MinSlack, slack);
+      slackSum += static_cast<double>(slack);
+
+      // The live tool doesn't measure the first cycle either, it has no previous one
+      if (index > 0 && start - previousStart > period)
+      {
+        result.MaxLatency = std::max(result.MaxLatency, start - previousStart - period);
+      }
+      previousStart = start;
+      previousFinish = finish;
+    }
+    result.MeanSlack = static_cast<int64_t>(slackSum / static_cast<double>(lateness.size()));
+    return result;
+  }
+
+  void PrintReplayTable(std::ostream& stream, const std::vector<ReplayResult>& results)
+  {
+    static constexpr int columnWidth = 10;
+    static constexpr const char* labels[] = { "Period us", "Budget us", "Rate Hz", "Cycles", "Max us", "Category", "Misses", "Min slack", "Mean slack", "Verdict" };
+
+    stream << "Replay verdict (slack in us)\n" << TableMaker::BeginRow << std::setfill(' ') << std::right;
+    for (const char* label : labels)
+    {
+      stream << std::setw(columnWidth) << label << TableMaker::Separator;
+    }
+    stream << "\n|";
+    for (size_t index = 0; index < std::size(labels); ++index)
+    {
+      stream << std::string(columnWidth + 2, TableMaker::Dash) << TableMaker::DashJoint;
+    }
+    stream << "\n";
+
+    const ReplayResult* best = nullptr;
+    for (const auto& result : results)
+    {
+      size_t bucketIndex = GetBucketIndex(result.MaxLatency, result.BucketWidth, BucketCount);
+      const char* verdictColor = result.Passed() ? BucketColorScheme::GetColor(0) : BucketColorScheme::GetColor(BucketCount - 1);
+      stream << TableMaker::BeginRow
+             << std::setw(columnWidth) << static_cast<uint64_t>(result.Period * NanoToMicro) << TableMaker::Separator
+             << std::setw(columnWidth) << static_cast<uint64_t>(result.Budget * NanoToMicro) << TableMaker::Separator
+             << std::setw(columnWidth) << NanoPerSec / result.Period << TableMaker::Separator
+             << std::setw(columnWidth) << result.Cycles << TableMaker::Separator
+             << BucketColorScheme::GetColor(bucketIndex) << std::setw(columnWidth) << static_cast<uint64_t>(result.MaxLatency * NanoToMicro)
+             << BucketColorScheme::GetResetColor() << TableMaker::Separator
+             << BucketColorScheme::GetColor(bucketIndex) << std::setw(columnWidth) << BucketColorScheme::GetCategory(bucketIndex)
+             << BucketColorScheme::GetResetColor() << TableMaker::Separator
+             << std::setw(columnWidth) << result.Misses << TableMaker::Separator
+             << std::setw(columnWidth) << static_cast<int64_t>(result.MinSlack * NanoToMicro) << TableMaker::Separator
+             << std::setw(columnWidth) << static_cast<int64_t>(result.MeanSlack * NanoToMicro) << TableMaker::Separator
+             << verdictColor << std::setw(columnWidth) << (result.Passed() ? "PASS" : "FAIL") << BucketColorScheme::GetResetColor()
+             << TableMaker::Separator << "\n";
+      if (result.Passed() && (best == nullptr || result.Period < best->Period)) { best = &result; }
+    }
+
+    if (best != nullptr)
+    {
+      stream << "Highest passing rate: " << NanoPerSec / best->Period << " Hz ("
+             << static_cast<uint64_t>(best->Period * NanoToMicro) << "us period, "
+             << static_cast<uint64_t>(best->Budget * NanoToMicro) << "us budget)\n";
+    }
+    else
+    {
+      stream << "No candidate passed.\n";
+    }
+  }
+} // end namespace Evaluator
@@ -16,6 +16,7 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 
+#include "eventlog.h"
 #include "nictest.h"
 
 static constexpr uint16_t EthernetFrameTypeBKHF = 0x88A4;
@@ -36,6 +37,8 @@ namespace Evaluator
     : params(argParams)
     , hardwareReport(std::move(hardwareReport))
     , softwareReport(std::move(softwareReport))
+    , handshakePhase(argParams.BucketWidth, argParams.Phases[static_cast<size_t>(CyclePhase::Handshake)], true)
+    , sendPhase(argParams.BucketWidth, argParams.Phases[static_cast<size_t>(CyclePhase::Send)], true)
   {
     // Create the socket
     socketDescriptor = socket(PF_PACKET, SOCK_RAW, htons(EthernetFrameTypeBKHF));
@@ -118,10 +121,10 @@ namespace Evaluator
     // std::cout << "Successfully set up EthercatNicTest" << std::endl;
   }
 
-  void EthercatNicTest::Send()
+  void BuildProbeFrame(ProbeFrame& frame)
   {
-    static constexpr size_t packetSize = 29;
-    unsigned char pData[packetSize] = {0};
+    frame.fill(0);
+    unsigned char* pData = frame.data();
 
     // Set the broadcast address as the destination in the frame data.
     unsigned char* macDestination = &pData[0];
@@ -148,9 +151,20 @@ namespace Evaluator
     pData[20] = 0x00; pData[21] = 0x05;
     // Set No roundtrip - Last Sub Command, also length?
     pData[22] = 0x01;
+  }
+
+  void EthercatNicTest::Send()
+  {
+    ProbeFrame frame;
+    BuildProbeFrame(frame);
 
+    const bool recordPhases = params.Phases[static_cast<size_t>(CyclePhase::Handshake)] != nullptr
+      && sendIteration >= params.WarmupCycles();
+    const int index = static_cast<int>(sendIteration);
     {
+      ScopedTimer handshakeTimer(handshakePhase, recordPhases, index);
       std::unique_lock lock(mutex);
+      const bool blocked = receiveIteration <= sendIteration;
       if (!condition.wait_for(lock, SocketTimeout,
         [this]
         {
@@ -162,10 +176,26 @@ namespace Evaluator
           sendIteration, receiveIteration);
         throw std::runtime_error(buffer);
       }
+
+      // Only a blocked sender measures the handoff; otherwise it never slept on the condition variable
+      if (params.Handoff != nullptr && sendIteration >= params.WarmupCycles())
+      {
+        if (blocked)
+        {
+          params.Handoff->AddObservation(GetCurrentTime() - notifyNanoseconds, static_cast<int>(sendIteration));
+        }
+        else
+        {
+          ++params.Handoff->unblocked;
+        }
+      }
     }
 
-    if (send(socketDescriptor, pData, packetSize, 0) == -1)
-    { throw std::runtime_error(AppendErrorCode("Failed to send data on socket.")); }
+    {
+      ScopedTimer sendTimer(sendPhase, recordPhases, index);
+      if (send(socketDescriptor, frame.data(), frame.size(), 0) == -1)
+      { throw std::runtime_error(AppendErrorCode("Failed to send data on socket.")); }
+    }
 
     ++sendIteration;
   }
@@ -187,14 +217,14 @@ namespace Evaluator
   {
     // Set up polling
     constexpr int numFds = 1; // number of file descriptors
-    static pollfd pollFd = { .fd=socketDescriptor, .events=POLLIN, .revents=0 };
     pollfd pollFds[numFds] = {};	// array of pollfd structs.
-    pollFds[0] = pollFd;
+    pollFds[0] = { .fd=socketDescriptor, .events=POLLIN, .revents=0 };
     constexpr int timeoutMs = 1000;
 
     {
       std::unique_lock lock(mutex);
       ++receiveIteration;
+      notifyNanoseconds = GetCurrentTime();
     }
     condition.notify_all();
 
@@ -230,7 +260,7 @@ namespace Evaluator
 
     ssize_t n = recvmsg(socketDescriptor, &msg, 0);
     if (n < 0) {
-      perror("recvmsg");
+      GetEventLog().Post(EventLevel::Error, "Receiver", "recvmsg failed", static_cast<int64_t>(receiveIteration), -1, errno);
       return false;
     }
 
@@ -255,6 +285,9 @@ namespace Evaluator
       }
     }
 
+    // Warm-up cycles are excluded from statistics, but still prime the previous timestamps
+    const bool recordTime = receiveIteration > params.WarmupCycles();
+
     // --- Inter-arrival delta for HW clock ---
     if (haveHardware)
     {
@@ -262,7 +295,7 @@ namespace Evaluator
       {
         int64_t delta = hardwareNanoseconds - prev.HardwareNanoseconds;
         // Inter-arrival should be non-negative; if negative, skip (clock step/rollover)
-        if (delta >= 0)
+        if (delta >= 0 && recordTime)
         {
           hardwareReport.AddObservation(static_cast<uint64_t>(delta), static_cast<int>(receiveIteration));
           stats.HardwareDeltaNanoseconds.update(delta, receiveIteration);
@@ -278,7 +311,7 @@ namespace Evaluator
       if (prev.HaveSoftware)
       {
         int64_t delta = softwareNanoseconds - prev.SoftwareNanoseconds;
-        if (delta >= 0)
+        if (delta >= 0 && recordTime)
         {
           softwareReport.AddObservation(static_cast<uint64_t>(delta), static_cast<int>(receiveIteration));
           stats.SoftwareDeltaNanoseconds.update(delta, receiveIteration);
@@ -0,0 +1,315 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <linux/sockios.h>
+#include <net/if.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "ethtool.h"
+#include "nictest.h"
+
+namespace Evaluator
+{
+  // Issue one SIOCETHTOOL command; `data` starts with the command word
+  static void EthtoolIoctl(std::string_view nic, void* data, const char* action)
+  {
+    if (nic.size() >= IFNAMSIZ)
+    {
+      throw std::runtime_error("Interface name \"" + std::string(nic) + "\" is too long.");
+    }
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to open a socket for ethtool."));
+    }
+    ifreq request = {};
+    std::memcpy(request.ifr_name, nic.data(), nic.size());
+    request.ifr_data = static_cast<char*>(data);
+    const int result = ioctl(fd, SIOCETHTOOL, &request);
+    const int error = errno;
+    close(fd);
+    if (result != 0)
+    {
+      errno = error;
+      throw EthtoolError(AppendErrorCode(std::string("Failed to ") + action + " of " + std::string(nic) + "."), error);
+    }
+  }
+
+  const char* GetCoalescingModeName(CoalescingMode mode)
+  {
+    switch (mode)
+    {
+      case CoalescingMode::Keep: return "keep";
+      case CoalescingMode::Rt: return "rt";
+    }
+    return "unknown";
+  }
+
+  std::optional<CoalescingMode> ParseCoalescingMode(std::string_view name)
+  {
+    for (CoalescingMode mode : { CoalescingMode::Keep, CoalescingMode::Rt })
+    {
+      if (name == GetCoalescingModeName(mode)) { return mode; }
+    }
+    return std::nullopt;
+  }
+
+  ethtool_coalesce GetCoalescing(std::string_view nic)
+  {
+    ethtool_coalesce settings = {};
+    settings.cmd = ETHTOOL_GCOALESCE;
+    EthtoolIoctl(nic, &settings, "read the interrupt coalescing");
+    return settings;
+  }
+
+  void SetCoalescing(std::string_view nic, const ethtool_coalesce& settings)
+  {
+    ethtool_coalesce request = settings;
+    request.cmd = ETHTOOL_SCOALESCE;
+    EthtoolIoctl(nic, &request, "set the interrupt coalescing");
+  }
+
+  ethtool_coalesce GetRtCoalescing(const ethtool_coalesce& settings)
+  {
+    ethtool_coalesce rt = settings;
+    rt.rx_coalesce_usecs = 0;
+    rt.rx_coalesce_usecs_irq = 0;
+    rt.tx_coalesce_usecs = 0;
+    rt.tx_coalesce_usecs_irq = 0;
+    rt.rx_max_coalesced_frames = std::min(rt.rx_max_coalesced_frames, 1U);
+    rt.rx_max_coalesced_frames_irq = std::min(rt.rx_max_coalesced_frames_irq, 1U);
+    rt.tx_max_coalesced_frames = std::min(rt.tx_max_coalesced_frames, 1U);
+    rt.tx_max_coalesced_frames_irq = std::min(rt.tx_max_coalesced_frames_irq, 1U);
+    rt.use_adaptive_rx_coalesce = 0;
+    rt.use_adaptive_tx_coalesce = 0;
+    return rt;
+  }
+
+  bool DelaysReceive(const ethtool_coalesce& settings)
+  {
+    return settings.rx_coalesce_usecs != 0 || settings.use_adaptive_rx_coalesce != 0 || settings.use_adaptive_tx_coalesce != 0;
+  }
+
+  std::string DescribeCoalescing(const ethtool_coalesce& settings)
+  {
+    std::ostringstream output;
+    output << "rx-usecs " << settings.rx_coalesce_usecs << " rx-frames " << settings.rx_max_coalesced_frames
+           << " tx-usecs " << settings.tx_coalesce_usecs << " tx-frames " << settings.tx_max_coalesced_frames
+           << " adaptive-rx " << (settings.use_adaptive_rx_coalesce ? "on" : "off")
+           << " adaptive-tx " << (settings.use_adaptive_tx_coalesce ? "on" : "off");
+    return output.str();
+  }
+
+  ethtool_ringparam GetRingParameters(std::string_view nic)
+  {
+    ethtool_ringparam settings = {};
+    settings.cmd = ETHTOOL_GRINGPARAM;
+    EthtoolIoctl(nic, &settings, "read the ring sizes");
+    return settings;
+  }
+
+  void SetRingParameters(std::string_view nic, const ethtool_ringparam& settings)
+  {
+    ethtool_ringparam request = settings;
+    request.cmd = ETHTOOL_SRINGPARAM;
+    EthtoolIoctl(nic, &request, "set the ring sizes");
+  }
+
+  static constexpr NicSetting AllNicSettings[] =
+  {
+    NicSetting::RxUsecs, NicSetting::RxFrames, NicSetting::TxUsecs, NicSetting::TxFrames, NicSetting::RxRing, NicSetting::TxRing
+  };
+
+  const char* GetNicSettingName(NicSetting setting)
+  {
+    switch (setting)
+    {
+      case NicSetting::RxUsecs: return "rx-usecs";
+      case NicSetting::RxFrames: return "rx-frames";
+      case NicSetting::TxUsecs: return "tx-usecs";
+      case NicSetting::TxFrames: return "tx-frames";
+      case NicSetting::RxRing: return "rx-ring";
+      case NicSetting::TxRing: return "tx-ring";
+    }
+    return "unknown";
+  }
+
+  std::optional<NicSetting> ParseNicSetting(std::string_view name)
+  {
+    for (NicSetting setting : AllNicSettings)
+    {
+      if (name == GetNicSettingName(setting)) { return setting; }
+    }
+    return std::nullopt;
+  }
+
+  std::string DescribeNicSettings(const NicSettingValues& values)
+  {
+    std::ostringstream output;
+    for (const auto& [setting, value] : values)
+    {
+      output << (output.tellp() > 0 ? " " : "") << GetNicSettingName(setting) << " " << value;
+    }
+    return output.str();
+  }
+
+  std::vector<NicSettingValues> ParseNicSweepGrid(std::string_view grid)
+  {
+    std::vector<NicSettingValues> points = { {} };
+    std::istringstream stream{std::string(grid)};
+    std::string axis;
+    while (std::getline(stream, axis, ';'))
+    {
+      if (axis.empty()) { continue; }
+      const size_t equals = axis.find('=');
+      auto setting = ParseNicSetting(std::string_view(axis).substr(0, equals));
+      if (equals == std::string::npos || !setting)
+      {
+        throw std::runtime_error("Invalid NIC sweep axis \"" + axis + "\"; expected <setting>=<value>,... with rx-usecs, rx-frames, tx-usecs, tx-frames, rx-ring or tx-ring.");
+      }
+      for (const auto& [existing, value] : points.front())
+      {
+        if (existing == *setting) { throw std::runtime_error("NIC sweep setting " + std::string(GetNicSettingName(*setting)) + " is listed twice."); }
+      }
+
+      std::vector<uint32_t> values;
+      std::istringstream valueStream(axis.substr(equals + 1));
+      std::string token;
+      while (std::getline(valueStream, token, ','))
+      {
+        uint32_t value = 0;
+        auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (token.empty() || error != std::errc() || end != token.data() + token.size())
+        {
+          throw std::runtime_error("Invalid value \"" + token + "\" for " + GetNicSettingName(*setting) + " in the NIC sweep.");
+        }
+        values.push_back(value);
+      }
+      if (values.empty())
+      {
+        throw std::runtime_error(std::string("No values for ") + GetNicSettingName(*setting) + " in the NIC sweep.");
+      }
+
+      std::vector<NicSettingValues> expanded;
+      for (const auto& point : points)
+      {
+        for (uint32_t value : values)
+        {
+          expanded.push_back(point);
+          expanded.back().emplace_back(*setting, value);
+        }
+      }
+      points = std::move(expanded);
+    }
+    if (points.front().empty())
+    {
+      throw std::runtime_error("The NIC sweep grid is empty.");
+    }
+    return points;
+  }
+
+  ScopedNicSettings::ScopedNicSettings(std::string argNic, bool includeCoalescing, bool includeRings)
+    : nic(std::move(argNic))
+  {
+    if (includeCoalescing)
+    {
+      try { coalescing = GetCoalescing(nic); } catch (const std::runtime_error& error) { coalescingError = error.what(); }
+    }
+    if (includeRings)
+    {
+      try { rings = GetRingParameters(nic); } catch (const std::runtime_error& error) { ringError = error.what(); }
+    }
+  }
+
+  ScopedNicSettings::~ScopedNicSettings()
+  {
+    if (coalescing)
+    {
+      try
+      {
+        SetCoalescing(nic, *coalescing);
+      }
+      catch (const std::exception& error)
+      {
+        std::cerr << "WARN: " << error.what() << " Restore it with: ethtool -C " << nic << " " << DescribeCoalescing(*coalescing) << "\n";
+      }
+    }
+    if (rings)
+    {
+      try
+      {
+        SetRingParameters(nic, *rings);
+      }
+      catch (const std::exception& error)
+      {
+        std::cerr << "WARN: " << error.what() << " Restore it with: ethtool -G " << nic << " rx " << rings->rx_pending << " tx " << rings->tx_pending << "\n";
+      }
+    }
+  }
+
+  void ScopedNicSettings::Apply(const NicSettingValues& values)
+  {
+    std::optional<ethtool_coalesce> coalescingRequest = coalescing;
+    if (coalescingRequest)
+    {
+      coalescingRequest->use_adaptive_rx_coalesce = 0;
+      coalescingRequest->use_adaptive_tx_coalesce = 0;
+    }
+    std::optional<ethtool_ringparam> ringRequest = rings;
+    for (const auto& [setting, value] : values)
+    {
+      const bool isRing = (setting == NicSetting::RxRing || setting == NicSetting::TxRing);
+      if (isRing ? !ringRequest : !coalescingRequest)
+      {
+        const std::string& reason = isRing ? ringError : coalescingError;
+        throw std::runtime_error(reason.empty() ? std::string(GetNicSettingName(setting)) + " of " + nic + " was not saved." : reason);
+      }
+      switch (setting)
+      {
+        case NicSetting::RxUsecs: coalescingRequest->rx_coalesce_usecs = value; break;
+        case NicSetting::RxFrames: coalescingRequest->rx_max_coalesced_frames = value; break;
+        case NicSetting::TxUsecs: coalescingRequest->tx_coalesce_usecs = value; break;
+        case NicSetting::TxFrames: coalescingRequest->tx_max_coalesced_frames = value; break;
+        case NicSetting::RxRing: ringRequest->rx_pending = value; break;
+        case NicSetting::TxRing: ringRequest->tx_pending = value; break;
+      }
+    }
+    if (ringRequest)
+    {
+      SetRingParameters(nic, *ringRequest);
+    }
+    if (coalescingRequest)
+    {
+      SetCoalescing(nic, *coalescingRequest);
+    }
+  }
+
+  ScopedRtCoalescing::ScopedRtCoalescing(std::string argNic)
+    : nic(std::move(argNic))
+    , original(GetCoalescing(nic))
+    , applied(GetRtCoalescing(original))
+  {
+    SetCoalescing(nic, applied);
+  }
+
+  ScopedRtCoalescing::~ScopedRtCoalescing()
+  {
+    try
+    {
+      SetCoalescing(nic, original);
+    }
+    catch (const std::exception& error)
+    {
+      std::cerr << "WARN: " << error.what() << " Restore it with: ethtool -C " << nic << " " << DescribeCoalescing(original) << "\n";
+    }
+  }
+} // end namespace Evaluator
@@ -0,0 +1,170 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <sys/mman.h>
+
+#include "eventlog.h"
+#include "nictest.h"
+#include "numa.h"
+#include "reporter.h"
+
+namespace Evaluator
+{
+  static constexpr size_t DefaultEventLogCapacity = 1024;
+
+  static void CopyTruncated(char* destination, size_t size, std::string_view source)
+  {
+    const size_t length = std::min(source.size(), size - 1);
+    std::memcpy(destination, source.data(), length);
+    destination[length] = '\0';
+  }
+
+  static const char* GetLevelName(EventLevel level)
+  {
+    switch (level)
+    {
+      case EventLevel::State: return "state";
+      case EventLevel::Threshold: return "threshold";
+      case EventLevel::Error: return "ERROR";
+    }
+    return "unknown";
+  }
+
+  EventLog::EventLog(size_t capacity)
+    : mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1)
+  {
+    static_assert(sizeof(Ring) % alignof(Cell) == 0);
+    const size_t cellCount = mask + 1;
+    mappingSize = sizeof(Ring) + cellCount * sizeof(Cell);
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to allocate the event log."));
+    }
+
+    ring = new (mapping) Ring();
+    cells = reinterpret_cast<Cell*>(static_cast<char*>(mapping) + sizeof(Ring));
+    for (uint64_t index = 0; index < cellCount; ++index)
+    {
+      Cell* cell = new (&cells[index]) Cell();
+      cell->Sequence.store(index, std::memory_order_relaxed);
+    }
+  }
+
+  EventLog::~EventLog()
+  {
+    munmap(ring, mappingSize);
+  }
+
+  void EventLog::BindToNode(int node)
+  {
+    BindMemoryToNode(ring, mappingSize, node);
+  }
+
+  bool EventLog::Post(EventLevel level, std::string_view source, std::string_view message,
+    int64_t index, int64_t nanoseconds, int error) noexcept
+  {
+    uint64_t position = ring->EnqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true)
+    {
+      cell = &cells[position & mask];
+      const uint64_t sequence = cell->Sequence.load(std::memory_order_acquire);
+      const int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+      if (difference == 0)
+      {
+        if (ring->EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (difference < 0)
+      {
+        ring->Dropped.fetch_add(1, std::memory_order_relaxed); // full
+        return false;
+      }
+      else
+      {
+        position = ring->EnqueuePosition.load(std::memory_order_relaxed);
+      }
+    }
+
+    Event& event = cell->Data;
+    event.Time = GetCurrentTime();
+    event.Index = index;
+    event.Nanoseconds = nanoseconds;
+    event.Error = error;
+    event.Level = level;
+    CopyTruncated(event.Source, Event::SourceSize, source);
+    CopyTruncated(event.Message, Event::MessageSize, message);
+    cell->Sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  int EventLog::Drain(std::ostream& stream, uint64_t startTime, bool includeState)
+  {
+    int lineCount = 0;
+    while (true)
+    {
+      Cell& cell = cells[dequeuePosition & mask];
+      if (cell.Sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+      {
+        break; // empty, or the next event is still being written
+      }
+      const Event event = cell.Data;
+      cell.Sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+      ++dequeuePosition;
+
+      if (event.Level == EventLevel::State && !includeState)
+      {
+        continue;
+      }
+
+      const double seconds = event.Time > startTime ? static_cast<double>(event.Time - startTime) / NanoPerSec : 0.0;
+      const char* color = (event.Level == EventLevel::State) ? BucketColorScheme::GetResetColor()
+        : BucketColorScheme::GetColor(event.Level == EventLevel::Error ? BucketCount - 1 : BucketCount - 2);
+      stream << "[" << std::setfill(' ') << std::fixed << std::setprecision(6) << std::setw(12) << seconds << std::defaultfloat << "] "
+             << color << GetLevelName(event.Level) << BucketColorScheme::GetResetColor() << " "
+             << event.Source << ": " << event.Message;
+      if (event.Index >= 0)
+      {
+        stream << " at index " << event.Index;
+      }
+      if (event.Nanoseconds >= 0)
+      {
+        stream << " (" << event.Nanoseconds / 1000 << "us)";
+      }
+      if (event.Error != 0)
+      {
+        stream << " | [" << event.Error << "] " << std::strerror(event.Error);
+      }
+      stream << "\n";
+      ++lineCount;
+    }
+
+    const uint64_t droppedNow = Dropped();
+    if (droppedNow != reportedDropped)
+    {
+      stream << BucketColorScheme::GetColor(BucketCount - 1) << (droppedNow - reportedDropped)
+             << " events dropped, the event log was full" << BucketColorScheme::GetResetColor() << "\n";
+      reportedDropped = droppedNow;
+      ++lineCount;
+    }
+    return lineCount;
+  }
+
+  // Constructed before main() so that the first post from an RT thread doesn't allocate
+  static EventLog eventLog(DefaultEventLogCapacity);
+
+  EventLog& GetEventLog()
+  {
+    return eventLog;
+  }
+} // end namespace Evaluator
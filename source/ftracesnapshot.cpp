@@ -0,0 +1,250 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ftracesnapshot.h"
+#include "nictest.h"
+
+namespace Evaluator
+{
+  static constexpr const char* TracefsRoots[] =
+  {
+    "/sys/kernel/tracing",
+    "/sys/kernel/debug/tracing"
+  };
+
+  // Everything that can take the CPU away from the RT thread or delay its wake-up
+  static constexpr const char* SnapshotEvents[] =
+  {
+    "sched/sched_switch",
+    "sched/sched_wakeup",
+    "irq/irq_handler_entry",
+    "irq/irq_handler_exit",
+    "irq/softirq_entry",
+    "irq/softirq_exit",
+    "timer/hrtimer_start",
+    "timer/hrtimer_cancel",
+    "timer/hrtimer_expire_entry",
+    "timer/hrtimer_expire_exit",
+  };
+
+  static constexpr int CpusPerMaskGroup = 32;
+
+  void WriteTracefs(const std::string& path, std::string_view value)
+  {
+    int fileDescriptor = open(path.c_str(), O_WRONLY | O_TRUNC | O_CLOEXEC);
+    if (fileDescriptor < 0)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to open " + path));
+    }
+    const ssize_t written = write(fileDescriptor, value.data(), value.size());
+    const int error = errno;
+    close(fileDescriptor);
+    if (written != static_cast<ssize_t>(value.size()))
+    {
+      errno = error;
+      throw std::runtime_error(AppendErrorCode("Failed to write \"" + std::string(value) + "\" to " + path));
+    }
+  }
+
+  std::string FindTracefs()
+  {
+    for (const char* root : TracefsRoots)
+    {
+      std::error_code error;
+      if (std::filesystem::is_directory(std::string(root) + "/instances", error))
+      {
+        return root;
+      }
+    }
+    throw std::runtime_error("tracefs is not mounted; mount it with \"mount -t tracefs nodev /sys/kernel/tracing\".");
+  }
+
+  std::string FormatCpuMask(const std::vector<int>& cpus)
+  {
+    const int highest = cpus.empty() ? 0 : *std::max_element(cpus.begin(), cpus.end());
+    std::vector<uint32_t> groups(highest / CpusPerMaskGroup + 1, 0);
+    for (int cpu : cpus)
+    {
+      groups[cpu / CpusPerMaskGroup] |= uint32_t{1} << (cpu % CpusPerMaskGroup);
+    }
+
+    std::string mask;
+    char buffer[16] = {};
+    for (size_t group = groups.size(); group-- > 0;)
+    {
+      std::snprintf(buffer, sizeof(buffer), mask.empty() ? "%x" : ",%08x", groups[group]);
+      mask += buffer;
+    }
+    return mask;
+  }
+
+  FtraceSnapshot::FtraceSnapshot(const std::string& directory, const std::vector<int>& cpus, uint64_t threshold,
+    size_t bufferKilobytes)
+    : directory(directory)
+    , threshold(threshold)
+  {
+    const std::string root = FindTracefs();
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+      throw std::runtime_error("Failed to create snapshot directory " + directory + ": " + error.message());
+    }
+
+    void* mapping = mmap(nullptr, sizeof(State), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to allocate the snapshot state."));
+    }
+    state = new (mapping) State();
+
+    instance = root + "/instances/rmp-eval-" + std::to_string(getpid());
+    if (mkdir(instance.c_str(), 0750) != 0)
+    {
+      munmap(state, sizeof(State));
+      throw std::runtime_error(AppendErrorCode("Failed to create tracefs instance " + instance));
+    }
+
+    try
+    {
+      std::error_code missing;
+      if (!std::filesystem::exists(instance + "/snapshot", missing))
+      {
+        throw std::runtime_error("This kernel has no ftrace snapshot support (CONFIG_TRACER_SNAPSHOT).");
+      }
+      WriteTracefs(instance + "/tracing_on", "0");
+      WriteTracefs(instance + "/buffer_size_kb", std::to_string(bufferKilobytes));
+      WriteTracefs(instance + "/tracing_cpumask", FormatCpuMask(cpus));
+      for (const char* event : SnapshotEvents)
+      {
+        WriteTracefs(instance + "/events/" + event + "/enable", "1");
+      }
+      // Allocate the snapshot buffer now rather than on the first spike, then empty it
+      WriteTracefs(instance + "/snapshot", "1");
+      WriteTracefs(instance + "/snapshot", "2");
+
+      snapshotFd = open((instance + "/snapshot").c_str(), O_WRONLY | O_CLOEXEC);
+      markerFd = open((instance + "/trace_marker").c_str(), O_WRONLY | O_CLOEXEC);
+      if (snapshotFd < 0 || markerFd < 0)
+      {
+        throw std::runtime_error(AppendErrorCode("Failed to open the snapshot files of " + instance));
+      }
+      WriteTracefs(instance + "/tracing_on", "1");
+    }
+    catch (...)
+    {
+      Remove();
+      throw;
+    }
+  }
+
+  FtraceSnapshot::~FtraceSnapshot()
+  {
+    Remove();
+  }
+
+  void FtraceSnapshot::Remove() noexcept
+  {
+    if (snapshotFd >= 0) { close(snapshotFd); snapshotFd = -1; }
+    if (markerFd >= 0) { close(markerFd); markerFd = -1; }
+    if (!instance.empty())
+    {
+      // Removing the instance also stops tracing and frees both buffers
+      if (rmdir(instance.c_str()) != 0)
+      {
+        std::perror(("WARN: remove tracefs instance " + instance).c_str());
+      }
+      instance.clear();
+    }
+    if (state != nullptr)
+    {
+      munmap(state, sizeof(State));
+      state = nullptr;
+    }
+  }
+
+  SnapshotDecision DecideSnapshot(uint64_t latency, uint64_t threshold, bool pending, uint64_t triggered)
+  {
+    if (latency < threshold) { return SnapshotDecision::Ignore; }
+    if (pending || triggered >= MaximumSnapshots) { return SnapshotDecision::Skip; }
+    return SnapshotDecision::Take;
+  }
+
+  bool FtraceSnapshot::Check(uint64_t latency, uint64_t index) noexcept
+  {
+    const SnapshotDecision decision = DecideSnapshot(latency, threshold,
+      state->Pending.load(std::memory_order_acquire) != 0, state->Triggered.load(std::memory_order_relaxed));
+    if (decision == SnapshotDecision::Ignore)
+    {
+      return false;
+    }
+    if (decision == SnapshotDecision::Skip)
+    {
+      state->Skipped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    // Formatted into the stack buffer without allocating
+    char marker[96] = {};
+    const int length = std::snprintf(marker, sizeof(marker), "rmp-eval: cycle %lu %lu ns late\n", index, latency);
+    if (length > 0)
+    {
+      [[maybe_unused]] ssize_t ignored = write(markerFd, marker, std::min<size_t>(length, sizeof(marker) - 1));
+    }
+
+    if (write(snapshotFd, "1", 1) != 1)
+    {
+      state->Skipped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    state->Triggered.fetch_add(1, std::memory_order_relaxed);
+    state->Pending.store(index + 1, std::memory_order_release);
+    return true;
+  }
+
+  uint64_t FtraceSnapshot::Save()
+  {
+    const uint64_t pending = state->Pending.load(std::memory_order_acquire);
+    if (pending == 0)
+    {
+      return 0;
+    }
+
+    const std::string path = directory + "/snapshot-" + std::to_string(pending - 1) + ".txt";
+    bool failed = true;
+    {
+      std::ifstream input(instance + "/snapshot");
+      std::ofstream output(path, std::ios::out | std::ios::trunc);
+      if (input.is_open() && output.is_open())
+      {
+        output << input.rdbuf();
+        output.close();
+        failed = output.fail();
+      }
+    }
+
+    // Empty the snapshot buffer without freeing it and let the RT thread take the next one
+    try { WriteTracefs(instance + "/snapshot", "2"); } catch (...) {}
+    state->Pending.store(0, std::memory_order_release);
+    if (failed)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to save ftrace snapshot to " + path));
+    }
+    ++saved;
+    return pending;
+  }
+} // end namespace Evaluator
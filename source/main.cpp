@@ -6,6 +6,7 @@
 #include <arpa/inet.h>
 #include <array>
 #include <barrier>
+#include <csignal>
 #include <cstring>
 #include <fcntl.h>
 #include <iomanip>
@@ -18,12 +19,17 @@
 #include <mutex>
 #include <netpacket/packet.h>
 #include <net/if.h>  // Gets the ifreq
+#include <optional>
 #include <poll.h>
 #include <pthread.h>
 #include <sched.h>
+#include <stop_token>
 #include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/signalfd.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <thread>
 #include <unistd.h>
 #include <unordered_set>
@@ -33,12 +39,24 @@
 #include "quantileestimator.h"
 #include "reporter.h"
 #include "nictest.h"
+#include "rtthread.h"
+#include "allocationguard.h"
+#include "checkpoint.h"
+#include "ethtool.h"
+#include "eventlog.h"
+#include "pingpong.h"
+#include "scenario.h"
+#include "signalbench.h"
+#include "tailestimate.h"
+#include "timerlat.h"
+#include "workerprocess.h"
 #include "commandlineparser.h"
 #include "config.h"
 #include "version.h"
 
 static std::mutex reportMutex;
 static std::atomic_bool testRunning = true;
+static std::atomic_bool stopRequested = false; // set on SIGINT/SIGTERM/SIGHUP; no further runs are started
 
 namespace Evaluator
 {
@@ -86,6 +104,81 @@ void ConfigureThisThread(int priority, int cpuCore)
   }
 }
 
+const char* GetSchedulerName(SchedulerPolicy policy)
+{
+  switch (policy)
+  {
+    case SchedulerPolicy::Fifo: return "FIFO";
+    case SchedulerPolicy::Deadline: return "DEADLINE";
+  }
+  return "Unknown";
+}
+
+std::optional<SchedulerPolicy> ParseSchedulerPolicy(std::string_view name)
+{
+  if (name == "fifo") { return SchedulerPolicy::Fifo; }
+  if (name == "deadline") { return SchedulerPolicy::Deadline; }
+  return std::nullopt;
+}
+
+// glibc only gained a sched_setattr() wrapper in 2.41, so mirror the kernel's struct sched_attr here
+// rather than including <linux/sched/types.h>, which conflicts with newer <sched.h> headers.
+struct SchedAttr
+{
+  uint32_t size;
+  uint32_t sched_policy;
+  uint64_t sched_flags;
+  int32_t  sched_nice;
+  uint32_t sched_priority;
+  uint64_t sched_runtime;
+  uint64_t sched_deadline;
+  uint64_t sched_period;
+};
+
+// Make the calling thread a SCHED_DEADLINE task. The CPU affinity must already be set.
+// The kernel refuses (EPERM) if the affinity mask does not span the whole root domain, so pinning a
+// deadline task to one core requires an exclusive cpuset (or the core being its own root domain).
+void SetDeadlineScheduler(uint64_t runtime, uint64_t deadline, uint64_t period)
+{
+  SchedAttr attributes = {};
+  attributes.size = sizeof(attributes);
+  attributes.sched_policy = SCHED_DEADLINE;
+  attributes.sched_runtime = runtime;
+  attributes.sched_deadline = deadline;
+  attributes.sched_period = period;
+
+  if (syscall(SYS_sched_setattr, 0, &attributes, 0) != 0)
+  {
+    std::string errorString = "Failed to set SCHED_DEADLINE (runtime=" + std::to_string(runtime) + "ns, period="
+      + std::to_string(period) + "ns). Pinned deadline tasks need an exclusive cpuset for the RT core";
+    throw std::runtime_error(AppendErrorCode(errorString));
+  }
+}
+
+void ConfigureThisThread(const TestParameters& params, int priority, int cpuCore)
+{
+  if (params.Scheduler == SchedulerPolicy::Fifo)
+  {
+    ConfigureThisThread(priority, cpuCore);
+    return;
+  }
+
+  cpu_set_t affinityMask;
+  CPU_ZERO(&affinityMask);
+  CPU_SET(cpuCore, &affinityMask);
+
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &affinityMask))
+  {
+    std::string errorString = "Failed to set the cpu affinity to CPU_CORE: " + std::to_string(cpuCore);
+    throw std::runtime_error(AppendErrorCode(errorString));
+  }
+
+  // implicit deadline: each job must finish within its own period
+  static constexpr uint64_t DeadlineRuntimeDivisor = 4; // reserve a quarter of each period by default
+  uint64_t runtime = params.DeadlineRuntime != 0 ? params.DeadlineRuntime : params.SendSleep / DeadlineRuntimeDivisor;
+  SetDeadlineScheduler(runtime, params.SendSleep, params.SendSleep);
+}
+
 static constexpr uint64_t RunIndefinitely = std::numeric_limits<uint64_t>::max();
 static constexpr uint64_t NanoPerMicro = 1000;
 
@@ -103,22 +196,65 @@ void AddNanoToTimespec(struct timespec* time, const uint64_t nanos)
   time->tv_nsec = nanoEpoch % Evaluator::NanoPerSec;
 }
 
+struct PageFaultCount
+{
+  uint64_t Minor = 0;
+  uint64_t Major = 0;
+};
+
+// Page faults incurred so far by the calling thread
+PageFaultCount GetThreadPageFaults()
+{
+  rusage usage = {};
+  getrusage(RUSAGE_THREAD, &usage);
+  return { static_cast<uint64_t>(usage.ru_minflt), static_cast<uint64_t>(usage.ru_majflt) };
+}
+
+// Post a threshold event when a period lands in the worst latency category. Called from the RT threads.
+void CheckLatencyThreshold(const TestParameters& params, std::string_view source, uint64_t period, uint64_t index)
+{
+  const uint64_t target = static_cast<uint64_t>(params.SendSleep);
+  const uint64_t latency = period > target ? period - target : 0;
+  if (GetBucketIndex(latency, params.BucketWidth, BucketCount) == BucketCount - 1)
+  {
+    GetEventLog().Post(EventLevel::Threshold, source, "period in the worst latency category",
+      static_cast<int64_t>(index), static_cast<int64_t>(period));
+  }
+}
+
 void SenderThread(TestParameters params, std::shared_ptr<INicTest> tester)
 {
+  const char* source = (tester != nullptr) ? "Sender" : "Cyclic";
   try
   {
-    ConfigureThisThread(params.SendPriority, params.SendCpu);
+    // FIFO threads already start with this policy, but SCHED_DEADLINE can't be set through pthread attributes
+    ConfigureThisThread(params, params.SendPriority, params.SendCpu);
 
     TimerReport report(params.SendSleep, params.BucketWidth, params.SendData);
+    if (params.SendResume != nullptr) { report.Restore(*params.SendResume); }
+    OverheadReport overhead(params.BucketWidth, params.SendOverhead);
+    OverheadReport wakePhase(params.BucketWidth, params.Phases[static_cast<size_t>(CyclePhase::Wake)], true);
+    OverheadReport postPhase(params.BucketWidth, params.Phases[static_cast<size_t>(CyclePhase::Post)], true);
+    const bool timePhases = params.Phases[static_cast<size_t>(CyclePhase::Wake)] != nullptr;
+    std::unique_ptr<IWakeTimer> timer = CreateWakeTimer(params.Wake);
+    const uint64_t warmupCycles = params.WarmupCycles();
+    PageFaultCount faultsAtStart;
     bool recordTime = true;
     uint64_t index = 0;
     struct timespec next = {};
     clock_gettime(CLOCK_MONOTONIC, &next);
     uint64_t previous = 0;
+    uint64_t wakeInstrumentation = 0; // time spent recording the wake-up, counted in the next cycle's overhead
+    std::optional<RtSection> rtSection(std::in_place, source);
     while (testRunning.load(std::memory_order_acquire) && (params.Iterations == RunIndefinitely || index < params.Iterations))
     {
       // decide whether to record this iteration's time
-      recordTime = (index != 0 && index != (params.Iterations -1));
+      recordTime = (index >= warmupCycles && index != (params.Iterations -1));
+      if (index == warmupCycles)
+      {
+        faultsAtStart = GetThreadPageFaults();
+        GetEventLog().Post(EventLevel::State, source, "warm-up done, measuring", static_cast<int64_t>(index));
+      }
   
       // call the desired method
       if (tester != nullptr)
@@ -126,11 +262,23 @@ void SenderThread(TestParameters params, std::shared_ptr<INicTest> tester)
         tester->Send();
       }
 
-      // ScopedTimer timer(report, recordTime, index);
       uint64_t current = Evaluator::GetCurrentTime();
       if (recordTime)
       {
         report.AddObservation(current - previous, index);
+        CheckLatencyThreshold(params, source, current - previous, index);
+        const uint64_t target = params.SendSleep;
+        const uint64_t latency = current - previous > target ? current - previous - target : 0;
+        if (params.Series != nullptr)
+        {
+          params.Series->Add(current, latency);
+        }
+        if (params.Snapshot != nullptr)
+        {
+          params.Snapshot->Check(latency, index);
+        }
+        // Everything above, plus what was recorded right after the last wake-up
+        overhead.AddObservation(Evaluator::GetCurrentTime() - current + wakeInstrumentation, index);
       }
   
       // Set up the next time to wake up
@@ -140,17 +288,39 @@ void SenderThread(TestParameters params, std::shared_ptr<INicTest> tester)
       {
         AddNanoToTimespec(&next, params.SendSleep);
       }
-      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr);
+      if (timePhases && recordTime)
+      {
+        postPhase.AddObservation(Evaluator::GetCurrentTime() - current, index);
+      }
+      timer->WaitUntil(next);
+      if ((params.Trace != nullptr || timePhases) && index + 1 >= warmupCycles)
+      {
+        const uint64_t woke = Evaluator::GetCurrentTime();
+        const uint64_t intended = Evaluator::ToEpoch(next);
+        const uint64_t lateness = woke > intended ? woke - intended : 0;
+        if (params.Trace != nullptr) { params.Trace->Record(lateness); }
+        if (timePhases) { wakePhase.AddObservation(lateness, index + 1); }
+        wakeInstrumentation = Evaluator::GetCurrentTime() - woke;
+      }
 
       previous = current;
       ++index;
     }
+
+    rtSection.reset();
+
+    if (index > warmupCycles)
+    {
+      PageFaultCount faults = GetThreadPageFaults();
+      report.SetPageFaults(faults.Minor - faultsAtStart.Minor, faults.Major - faultsAtStart.Major);
+    }
   }
   catch (const std::exception& error)
   {
     testRunning.store(false, std::memory_order_release);
-    std::cout << "Error occurred in Sender Thread: " << error.what() << std::endl;
+    GetEventLog().Post(EventLevel::Error, source, error.what());
   }
+  GetEventLog().Post(EventLevel::State, source, "stopped");
 }
 
 
@@ -158,23 +328,34 @@ void ReceiverThread(TestParameters params, std::shared_ptr<INicTest> tester)
 {
   try
   {
-    ConfigureThisThread(params.ReceivePriority, params.ReceiveCpu);
+    ConfigureThisThread(params, params.ReceivePriority, params.ReceiveCpu);
 
     TimerReport report(params.SendSleep, params.BucketWidth, params.ReceiveData);
+    if (params.TrackReceiveP99) { report.TrackP99(); }
+    if (params.ReceiveResume != nullptr) { report.Restore(*params.ReceiveResume); }
+    OverheadReport overhead(params.BucketWidth, params.ReceiveOverhead);
+    const uint64_t warmupCycles = params.WarmupCycles();
+    PageFaultCount faultsAtStart;
     bool recordTime = true;
 
     uint64_t index = 0;
     uint64_t previous = 0;
+    std::optional<RtSection> rtSection(std::in_place, "Receiver");
     while (testRunning.load(std::memory_order_acquire) && (params.Iterations == RunIndefinitely || index < params.Iterations))
     {
       // decide whether to record this iteration's time
-      recordTime = (index != 0 && index != (params.Iterations -1));
+      recordTime = (index >= warmupCycles && index != (params.Iterations -1));
+      if (index == warmupCycles)
+      {
+        faultsAtStart = GetThreadPageFaults();
+        GetEventLog().Post(EventLevel::State, "Receiver", "warm-up done, measuring", static_cast<int64_t>(index));
+      }
 
       // call the desired method
       if (tester->Receive() != true)
       {
         testRunning.store(false, std::memory_order_release);
-        std::cout << "Failed to receive message on index " << index << std::endl;
+        GetEventLog().Post(EventLevel::Error, "Receiver", "Failed to receive message", static_cast<int64_t>(index));
         break;
       }
 
@@ -182,17 +363,28 @@ void ReceiverThread(TestParameters params, std::shared_ptr<INicTest> tester)
       if (recordTime)
       {
         report.AddObservation(current - previous, index);
+        CheckLatencyThreshold(params, "Receiver", current - previous, index);
+        overhead.AddObservation(Evaluator::GetCurrentTime() - current, index);
       }
 
       previous = current;
       ++index;
     }
+
+    rtSection.reset();
+
+    if (index > warmupCycles)
+    {
+      PageFaultCount faults = GetThreadPageFaults();
+      report.SetPageFaults(faults.Minor - faultsAtStart.Minor, faults.Major - faultsAtStart.Major);
+    }
   }
   catch (const std::exception& error)
   {
     testRunning.store(false, std::memory_order_release);
-    std::cout << "Error occurred in Receiver Thread: " << error.what() << std::endl;
+    GetEventLog().Post(EventLevel::Error, "Receiver", error.what());
   }
+  GetEventLog().Post(EventLevel::State, "Receiver", "stopped");
 }
 
 // Write a trace marker to be read via trace-cmd
@@ -298,10 +490,22 @@ FileDescriptor SetLatencyTarget()
 using ReportPair = std::pair<std::string_view, ReportData*>;
 using ReportVector = std::vector<ReportPair>;
 
-void PrintReport(ReportVector& reports, int& lineCount, Evaluator::TableMaker& tableMaker,
+void PrintReport(const ReportVector& liveReports, int& lineCount, Evaluator::TableMaker& tableMaker,
   std::chrono::steady_clock::time_point startTime, std::chrono::steady_clock::time_point endTime,
-  std::ostream& stream)
+  std::ostream& stream, bool isVerbose)
 {
+  // Consistent copies of the rows, which the RT threads keep updating
+  std::vector<ReportData> rows;
+  rows.reserve(liveReports.size());
+  ReportVector reports;
+  for (auto [label, dataPtr] : liveReports)
+  {
+    if (dataPtr != nullptr)
+    {
+      reports.emplace_back(label, &rows.emplace_back(ReadReportData(*dataPtr)));
+    }
+  }
+
   // Recalculate column widths based on actual data
   tableMaker.OptimizeColumnWidthsFromData(reports);
 
@@ -313,6 +517,10 @@ void PrintReport(ReportVector& reports, int& lineCount, Evaluator::TableMaker& t
   }
   lineCount = 0;
 
+  // Events posted by the RT threads since the last redraw scroll up above the table
+  const uint64_t startNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(startTime.time_since_epoch()).count();
+  GetEventLog().Drain(stream, startNanoseconds, isVerbose);
+
   // Reprint header with updated widths
   lineCount += tableMaker.PrintLabels(stream);
 
@@ -322,8 +530,14 @@ void PrintReport(ReportVector& reports, int& lineCount, Evaluator::TableMaker& t
     if (dataPtr != nullptr)
     {
       lineCount += tableMaker.PrintRow(label, *dataPtr, stream);
+      if (dataPtr->isOverhead)
+      {
+        lineCount += tableMaker.PrintOverheadSummary(summary, label, *dataPtr);
+        continue;
+      }
       tableMaker.PrintMaxLatencySummary(summary, label, *dataPtr);
       lineCount += 1;
+      lineCount += tableMaker.PrintPageFaultSummary(summary, label, *dataPtr);
     }
   }
   lineCount += Evaluator::FormatDuration(startTime, endTime);
@@ -335,16 +549,763 @@ void PrintReport(ReportVector& reports, int& lineCount, Evaluator::TableMaker& t
 // live reporter interval at 20Hz
 static constexpr auto ReportInterval = std::chrono::milliseconds(50);
 void ReportThread(ReportVector& reports, int& lineCount, Evaluator::TableMaker& tableMaker,
-  std::chrono::steady_clock::time_point startTime, std::atomic_bool& liveReport, std::ostream& stream)
+  std::chrono::steady_clock::time_point startTime, std::atomic_bool& liveReport, std::ostream& stream, bool isVerbose)
 {
   while(liveReport.load(std::memory_order_acquire))
   {
     std::unique_lock lock(reportMutex);
     auto currentTime = std::chrono::steady_clock::now();
-    PrintReport(reports, lineCount, tableMaker, startTime, currentTime, stream);
+    PrintReport(reports, lineCount, tableMaker, startTime, currentTime, stream, isVerbose);
     std::this_thread::sleep_for(ReportInterval);
   }
 }
+
+struct HousekeepingOptions
+{
+  int SignalFd = -1;               // signalfd for the shutdown signals, which every other thread blocks
+  std::string CheckpointPath;      // empty to disable checkpoints
+  std::chrono::seconds CheckpointInterval{60};
+  const Checkpoint* Resume = nullptr;
+};
+static HousekeepingOptions housekeeping;
+
+// Block the shutdown signals in the calling thread (and every thread it creates afterwards) and return a
+// signalfd that reports them, so Ctrl+C ends the run cleanly and the final report is always printed.
+int CreateShutdownSignalFd()
+{
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  sigaddset(&signals, SIGHUP);
+  if (pthread_sigmask(SIG_BLOCK, &signals, nullptr) != 0)
+  {
+    throw std::runtime_error(AppendErrorCode("Failed to block shutdown signals."));
+  }
+  int signalFd = signalfd(-1, &signals, SFD_CLOEXEC);
+  if (signalFd == -1)
+  {
+    throw std::runtime_error(AppendErrorCode("Failed to create signalfd."));
+  }
+  return signalFd;
+}
+
+Checkpoint MakeCheckpoint(const TestParameters& params, const ReportVector& reports)
+{
+  Checkpoint checkpoint;
+  checkpoint.Period = params.SendSleep;
+  checkpoint.BucketWidth = params.BucketWidth;
+  for (auto [label, dataPtr] : reports)
+  {
+    checkpoint.Rows.emplace_back(std::string(label), ReadReportData(*dataPtr));
+  }
+  return checkpoint;
+}
+
+// Non-RT thread that watches for shutdown signals, periodically checkpoints the statistics and writes out
+// the recorded cycles and ftrace snapshots.
+void HousekeepingThread(std::stop_token stopToken, const TestParameters& params, const ReportVector& reports)
+{
+  static constexpr int PollTimeoutMs = 100;
+  auto nextCheckpoint = std::chrono::steady_clock::now() + housekeeping.CheckpointInterval;
+  auto saveCheckpoint = [&]
+  {
+    try
+    {
+      SaveCheckpoint(housekeeping.CheckpointPath, MakeCheckpoint(params, reports));
+    }
+    catch (const std::exception& error)
+    {
+      std::cerr << "WARN: " << error.what() << "\n";
+    }
+  };
+
+  auto saveSnapshot = [&params]
+  {
+    try
+    {
+      if (uint64_t saved = params.Snapshot->Save(); saved > 0)
+      {
+        GetEventLog().Post(EventLevel::State, "Snapshot", "ftrace snapshot saved", static_cast<int64_t>(saved - 1));
+      }
+    }
+    catch (const std::exception& error)
+    {
+      GetEventLog().Post(EventLevel::Error, "Snapshot", error.what());
+    }
+  };
+
+  while (!stopToken.stop_requested())
+  {
+    pollfd pollFd = { .fd = housekeeping.SignalFd, .events = POLLIN, .revents = 0 };
+    if (poll(&pollFd, housekeeping.SignalFd >= 0 ? 1 : 0, PollTimeoutMs) > 0)
+    {
+      signalfd_siginfo info;
+      if (read(housekeeping.SignalFd, &info, sizeof(info)) == sizeof(info))
+      {
+        stopRequested.store(true, std::memory_order_release);
+        testRunning.store(false, std::memory_order_release);
+      }
+    }
+
+    if (!housekeeping.CheckpointPath.empty() && std::chrono::steady_clock::now() >= nextCheckpoint)
+    {
+      saveCheckpoint();
+      nextCheckpoint += housekeeping.CheckpointInterval;
+    }
+
+    if (params.Trace != nullptr)
+    {
+      params.Trace->Flush();
+    }
+    if (params.Snapshot != nullptr)
+    {
+      saveSnapshot();
+    }
+  }
+
+  if (params.Snapshot != nullptr)
+  {
+    saveSnapshot();
+  }
+
+  if (!housekeeping.CheckpointPath.empty())
+  {
+    saveCheckpoint();
+  }
+}
+
+static constexpr char NoNicSelected[] = "NoNicSelected";
+
+// SCHED_DEADLINE can't be requested through pthread attributes, so those threads start as SCHED_OTHER
+// and switch policy themselves in ConfigureThisThread().
+RtThreadAttributes GetRtThreadAttributes(const TestParameters& params, int priority, int cpuCore)
+{
+  RtThreadAttributes attributes;
+  attributes.Policy = (params.Scheduler == SchedulerPolicy::Fifo) ? SCHED_FIFO : SCHED_OTHER;
+  attributes.Priority = priority;
+  attributes.Cpu = cpuCore;
+  attributes.MemoryNode = params.MemoryNode;
+  return attributes;
+}
+
+// Start the RT threads for `params` and block until they finish. Runs either in this process or in the
+// RT worker process, see --isolation.
+void RunWorkers(const TestParameters& params, ReportData& hardwareData, ReportData& softwareData)
+{
+  if (params.NicName == NoNicSelected)
+  {
+    RtThread cyclicThread(GetRtThreadAttributes(params, params.SendPriority, params.SendCpu),
+      [&params] { SenderThread(params, nullptr); });
+    cyclicThread.Join();
+    testRunning.store(false, std::memory_order_release);
+    return;
+  }
+
+  // The sample reports and socket buffers shared by both RT threads go on the sender's node
+  std::shared_ptr<INicTest> tester;
+  {
+    ScopedMemoryNode memoryPolicy(ResolveMemoryNode(params.MemoryNode, params.SendCpu));
+    TimerReport hardwareReport(params.SendSleep, params.BucketWidth, &hardwareData);
+    TimerReport softwareReport(params.SendSleep, params.BucketWidth, &softwareData);
+    if (housekeeping.Resume != nullptr)
+    {
+      if (auto data = housekeeping.Resume->Find("HW delta")) { hardwareReport.Restore(*data); }
+      if (auto data = housekeeping.Resume->Find("SW delta")) { softwareReport.Restore(*data); }
+    }
+    tester = std::make_shared<EthercatNicTest>(params, std::move(hardwareReport), std::move(softwareReport));
+  }
+
+  RtThread receiverThread(GetRtThreadAttributes(params, params.ReceivePriority, params.ReceiveCpu),
+    [&params, tester] { ReceiverThread(params, tester); });
+  RtThread senderThread(GetRtThreadAttributes(params, params.SendPriority, params.SendCpu),
+    [&params, tester] { SenderThread(params, tester); });
+
+  receiverThread.Join();
+  testRunning.store(false, std::memory_order_release);
+  senderThread.Join();
+}
+
+// Rows for the phases of the cyclic/sender cycle, in CyclePhase order; the cyclic test has no handshake or send()
+void AddPhaseRows(ReportVector& reports, const TestParameters& params)
+{
+  static constexpr std::array<std::string_view, CyclePhaseCount> SenderLabels =
+    { "Sender wake", "Sender handshake", "Sender send()", "Sender post" };
+  static constexpr std::array<std::string_view, CyclePhaseCount> CyclicLabels =
+    { "Cyclic wake", "", "", "Cyclic post" };
+  const auto& labels = (params.NicName == NoNicSelected) ? CyclicLabels : SenderLabels;
+  for (size_t phase = 0; phase < CyclePhaseCount; ++phase)
+  {
+    if (params.Phases[phase] != nullptr && !labels[phase].empty())
+    {
+      reports.push_back({labels[phase], params.Phases[phase]});
+    }
+  }
+}
+
+using LabeledReport = std::pair<std::string, ReportData>;
+using LabeledReports = std::vector<LabeledReport>;
+
+// Run a single measurement with the given parameters, showing the live table while it runs and the
+// final table once it is done. Results are left in params.SendData/ReceiveData and the HW/SW delta rows,
+// and a copy of each final row is returned.
+LabeledReports RunTest(const TestParameters& params, ReportData& hardwareData, ReportData& softwareData)
+{
+  *params.SendData = ReportData{};
+  *params.ReceiveData = ReportData{};
+  *params.SendOverhead = ReportData{};
+  *params.ReceiveOverhead = ReportData{};
+  *params.Handoff = HandoffHistogram{};
+  for (ReportData* phase : params.Phases)
+  {
+    if (phase != nullptr) { *phase = ReportData{}; }
+  }
+  if (params.Series != nullptr)
+  {
+    // Spikes are cycles past "Good", the same line the verdicts draw
+    params.Series->Reset(std::max<uint64_t>(DefaultSeriesWindow, params.SendSleep), params.BucketWidth << RunVerdict::PassBucketIndex);
+  }
+  hardwareData = ReportData{};
+  softwareData = ReportData{};
+  testRunning.store(true, std::memory_order_release);
+  std::atomic_bool liveReport = true;
+
+  // The rings the RT threads write every cycle are mapped by the main thread, so move them to the sender's
+  // node. Done before the fork: mbind() doesn't move pages that are mapped by both processes.
+  const int ringNode = ResolveMemoryNode(params.MemoryNode, params.SendCpu);
+  if (ringNode != UnboundMemoryNode)
+  {
+    GetEventLog().BindToNode(ringNode);
+    if (params.Trace != nullptr) { params.Trace->BindToNode(ringNode); }
+    if (params.Series != nullptr) { params.Series->BindToNode(ringNode); }
+  }
+
+  if (stopRequested.load(std::memory_order_acquire))
+  {
+    return {};
+  }
+
+  // Set before the worker forks and restored when the run is over, including on errors and Ctrl+C
+  std::optional<ScopedRtCoalescing> coalescing;
+  if (params.Coalescing == CoalescingMode::Rt && params.NicName != NoNicSelected)
+  {
+    coalescing.emplace(params.NicName);
+    std::cout << "Coalescing on " << params.NicName << ": " << DescribeCoalescing(coalescing->Applied())
+              << " (was " << DescribeCoalescing(coalescing->Original()) << ")\n\n" << std::flush;
+  }
+
+  std::optional<ScopedNicThreadPriority> nicThreads;
+  if (params.NicThreadPriority != KeepNicThreadPriority && params.NicName != NoNicSelected)
+  {
+    nicThreads.emplace(params.NicName, params.NicThreadPriority);
+    std::cout << "NIC threads of " << params.NicName << ": " << nicThreads->Original().size() << " set to "
+              << DescribeSchedulingPolicy(SCHED_FIFO, params.NicThreadPriority) << "\n\n" << std::flush;
+  }
+
+  auto startTime = std::chrono::steady_clock::now();
+
+  // Fork while this is still the only thread, see WorkerProcess
+  std::optional<WorkerProcess> process;
+  if (params.Isolation == WorkerIsolation::Process)
+  {
+    process.emplace(params, RunWorkers, testRunning);
+  }
+  const TestParameters& workerParams = process ? process->Parameters() : params;
+
+  // Started after the fork, since it reads the trace in a thread of this process
+  ReportData kernelIrqData, kernelThreadData;
+  std::optional<TimerlatTracer> timerlat;
+  if (params.KernelTimerlat)
+  {
+    timerlat.emplace(params.SendCpu, params.SendSleep, params.BucketWidth, params.WarmupCycles(), &kernelIrqData, &kernelThreadData);
+  }
+  ReportData& workerHardwareData = process ? process->HardwareData() : hardwareData;
+  ReportData& workerSoftwareData = process ? process->SoftwareData() : softwareData;
+
+  TableMaker tableMaker = TableMaker::CreateTableMaker(params.BucketWidth, params.IsVerbose);
+
+  int lineCount = 0;
+  ReportVector reports;
+  if (params.NicName == NoNicSelected)
+  {
+    reports.push_back({"Cyclic", workerParams.SendData});
+    if (params.IsVerbose)
+    {
+      reports.push_back({"Cyclic overhead", workerParams.SendOverhead});
+      AddPhaseRows(reports, workerParams);
+    }
+  }
+  else
+  {
+    reports.push_back({"Sender", workerParams.SendData});
+    reports.push_back({"Receiver", workerParams.ReceiveData});
+    if (params.IsVerbose)
+    {
+      reports.push_back({"HW delta", &workerHardwareData});
+      reports.push_back({"SW delta", &workerSoftwareData});
+      reports.push_back({"Sender overhead", workerParams.SendOverhead});
+      reports.push_back({"Receiver overhead", workerParams.ReceiveOverhead});
+      AddPhaseRows(reports, workerParams);
+    }
+  }
+  if (timerlat)
+  {
+    reports.push_back({"Kernel IRQ", &kernelIrqData});
+    reports.push_back({"Kernel thread", &kernelThreadData});
+  }
+  tableMaker.OptimizeRowLabelWidth(reports);
+
+  std::jthread housekeepingThread(HousekeepingThread, std::cref(workerParams), std::cref(reports));
+  std::thread reportThread(ReportThread, std::ref(reports), std::ref(lineCount), std::ref(tableMaker),
+    startTime, std::ref(liveReport), std::ref(std::cout), params.IsVerbose);
+
+  auto stopReporting = [&]
+  {
+    testRunning.store(false, std::memory_order_release);
+    liveReport.store(false, std::memory_order_release);
+    reportThread.join();
+    housekeepingThread.request_stop();
+    housekeepingThread.join();
+  };
+
+  try
+  {
+    if (process)
+    {
+      process->Wait(testRunning);
+    }
+    else
+    {
+      RunWorkers(params, hardwareData, softwareData);
+    }
+  }
+  catch (const std::exception&)
+  {
+    stopReporting();
+    // Show what the RT threads reported before the error
+    const uint64_t startNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(startTime.time_since_epoch()).count();
+    GetEventLog().Drain(std::cout, startNanoseconds, params.IsVerbose);
+    throw;
+  }
+  stopReporting();
+  timerlat.reset();
+
+  std::cout << std::flush;
+  PrintReport(reports, lineCount, tableMaker, startTime, std::chrono::steady_clock::now(), std::cout, params.IsVerbose);
+  for (auto [label, dataPtr] : reports)
+  {
+    if (!dataPtr->isOverhead)
+    {
+      PrintTailEstimate(std::cout, label, *dataPtr);
+    }
+  }
+  if (params.Series != nullptr)
+  {
+    PrintPeriodicity(std::cout, params.NicName == NoNicSelected ? "Cyclic" : "Sender", *params.Series);
+  }
+  std::cout << std::flush;
+
+  LabeledReports rows;
+  for (auto [label, dataPtr] : reports)
+  {
+    rows.emplace_back(std::string(label), *dataPtr);
+  }
+  if (process)
+  {
+    process->CopyResults(params, hardwareData, softwareData);
+  }
+  if (params.NicName != NoNicSelected)
+  {
+    std::ostringstream label;
+    label << "Sender wake after receiver notify (CPU " << params.ReceiveCpu << " -> CPU " << params.SendCpu
+          << (params.ReceiveCpu == params.SendCpu ? ", same core)" : ", cross-core)");
+    PrintHandoffHistogram(std::cout, label.str(), *params.Handoff);
+    std::cout << "\n" << std::flush;
+  }
+  return rows;
+}
+
+// Print the rows of several runs in one table so that they can be compared side by side.
+// All runs must share the same bucket width.
+void PrintComparison(std::string_view title, LabeledReports& rows, uint64_t bucketWidth, bool isVerbose)
+{
+  TableMaker tableMaker = TableMaker::CreateTableMaker(bucketWidth, isVerbose);
+  ReportVector reports;
+  for (auto& [label, data] : rows)
+  {
+    reports.push_back({label, &data});
+  }
+  tableMaker.OptimizeRowLabelWidth(reports);
+  tableMaker.OptimizeColumnWidthsFromData(reports);
+
+  std::cout << title << "\n";
+  tableMaker.PrintLabels(std::cout);
+  std::stringstream summary;
+  for (auto [label, dataPtr] : reports)
+  {
+    tableMaker.PrintRow(label, *dataPtr, std::cout);
+    if (dataPtr->isOverhead)
+    {
+      tableMaker.PrintOverheadSummary(summary, label, *dataPtr);
+    }
+    else
+    {
+      tableMaker.PrintMaxLatencySummary(summary, label, *dataPtr);
+    }
+  }
+  std::cout << summary.str() << "\n" << std::flush;
+}
+
+// Append the rows of a run to a comparison, prefixing each label with the name of the run.
+void AppendComparisonRows(LabeledReports& comparison, std::string_view prefix, const LabeledReports& rows)
+{
+  for (const auto& [label, data] : rows)
+  {
+    comparison.emplace_back(std::string(prefix) + " " + label, data);
+  }
+}
+
+using ComparisonVariant = std::pair<std::string, TestParameters>;
+
+// Run the same workload once per variant and show all results together in one table.
+void RunComparison(std::string_view title, const std::vector<ComparisonVariant>& variants,
+  ReportData& hardwareData, ReportData& softwareData)
+{
+  LabeledReports comparison;
+  for (const auto& [name, params] : variants)
+  {
+    std::cout << title << ": " << name << "\n\n" << std::flush;
+    AppendComparisonRows(comparison, name, RunTest(params, hardwareData, softwareData));
+    if (stopRequested.load(std::memory_order_acquire)) { break; }
+  }
+  if (!variants.empty())
+  {
+    PrintComparison(std::string(title) + " comparison", comparison, variants.front().second.BucketWidth, variants.front().second.IsVerbose);
+  }
+}
+
+// Run the same workload under SCHED_FIFO and then SCHED_DEADLINE.
+void RunSchedulerComparison(TestParameters params, ReportData& hardwareData, ReportData& softwareData)
+{
+  std::vector<ComparisonVariant> variants;
+  for (SchedulerPolicy policy : { SchedulerPolicy::Fifo, SchedulerPolicy::Deadline })
+  {
+    params.Scheduler = policy;
+    variants.emplace_back(GetSchedulerName(policy), params);
+  }
+  RunComparison("Scheduler", variants, hardwareData, softwareData);
+}
+
+// Run the same workload on the same core once per wake mechanism.
+void RunWakeMechanismComparison(TestParameters params, ReportData& hardwareData, ReportData& softwareData)
+{
+  std::vector<ComparisonVariant> variants;
+  for (WakeMechanism mechanism : AllWakeMechanisms)
+  {
+    params.Wake = mechanism;
+    variants.emplace_back(GetWakeMechanismName(mechanism), params);
+  }
+  RunComparison("Timer", variants, hardwareData, softwareData);
+}
+
+// Run the same workload with the RT threads in this process and then in a separate worker process.
+void RunIsolationComparison(TestParameters params, ReportData& hardwareData, ReportData& softwareData)
+{
+  std::vector<ComparisonVariant> variants;
+  for (WorkerIsolation isolation : { WorkerIsolation::Thread, WorkerIsolation::Process })
+  {
+    params.Isolation = isolation;
+    variants.emplace_back(GetWorkerIsolationName(isolation), params);
+  }
+  RunComparison("Isolation", variants, hardwareData, softwareData);
+}
+
+// Run the same workload with the NIC's current interrupt coalescing and then with coalescing turned off,
+// to show how much of the receive latency is interrupt moderation.
+void RunCoalescingComparison(TestParameters params, ReportData& hardwareData, ReportData& softwareData)
+{
+  std::vector<ComparisonVariant> variants;
+  for (CoalescingMode mode : { CoalescingMode::Keep, CoalescingMode::Rt })
+  {
+    params.Coalescing = mode;
+    variants.emplace_back(GetCoalescingModeName(mode), params);
+  }
+  RunComparison("Coalescing", variants, hardwareData, softwareData);
+}
+
+// Run the same workload with the NIC's IRQ/NAPI threads as they are and then just below the RT threads.
+void RunNicThreadPriorityComparison(TestParameters params, ReportData& hardwareData, ReportData& softwareData)
+{
+  std::vector<ComparisonVariant> variants;
+  params.NicThreadPriority = KeepNicThreadPriority;
+  variants.emplace_back("keep", params);
+  params.NicThreadPriority = GetRecommendedNicThreadPriority(params.SendPriority, params.ReceivePriority);
+  variants.emplace_back("fifo-" + std::to_string(params.NicThreadPriority), params);
+  RunComparison("NIC thread priority", variants, hardwareData, softwareData);
+}
+
+// Run the same workload with the RT threads' memory on their own NUMA node and then on another node,
+// to show what cross-node placement costs on this machine.
+void RunMemoryNodeComparison(TestParameters params, ReportData& hardwareData, ReportData& softwareData)
+{
+  const std::vector<int> nodes = GetOnlineNumaNodes();
+  const std::optional<int> localNode = GetCpuNumaNode(params.SendCpu);
+  auto remoteNode = std::find_if(nodes.begin(), nodes.end(), [&localNode](int node) { return node != localNode; });
+  if (!localNode || remoteNode == nodes.end())
+  {
+    throw std::runtime_error("--memory-node compare needs a machine with at least two NUMA nodes; this one has "
+      + std::to_string(nodes.size()) + ".");
+  }
+  std::cout << "Local node: " << *localNode << ", remote node: " << *remoteNode << "\n";
+
+  std::vector<ComparisonVariant> variants;
+  params.MemoryNode = *localNode;
+  variants.emplace_back("local", params);
+  params.MemoryNode = *remoteNode;
+  variants.emplace_back("remote", params);
+  RunComparison("Memory node", variants, hardwareData, softwareData);
+}
+
+// Summarize the run that just finished with `params` as a pass/fail verdict
+RunVerdict GetRunVerdict(std::string label, const TestParameters& params)
+{
+  RunVerdict result;
+  result.Label = std::move(label);
+  result.Period = params.SendSleep;
+  result.BucketWidth = params.BucketWidth;
+  result.Observations = params.SendData->observations;
+  result.Completed = params.SendData->observations + params.WarmupCycles() + 1 >= params.Iterations; // warm-up and last cycles are not recorded
+  result.AddRow(*params.SendData);
+  if (params.NicName != NoNicSelected)
+  {
+    result.AddRow(*params.ReceiveData);
+  }
+  return result;
+}
+
+// Parse a comma separated list of periods in microseconds, e.g. "2000,1000,500,250,125"
+std::vector<uint64_t> ParsePeriodList(const std::string& list)
+{
+  std::vector<uint64_t> periods;
+  std::stringstream stream(list);
+  std::string token;
+  while (std::getline(stream, token, ','))
+  {
+    if (token.empty()) { continue; }
+    size_t parsed = 0;
+    uint64_t period = 0;
+    try { period = std::stoull(token, &parsed); } catch (...) { parsed = 0; }
+    if (parsed != token.size() || period == 0)
+    {
+      throw std::runtime_error("Invalid period \"" + token + "\" in period list \"" + list + "\".");
+    }
+    periods.push_back(period);
+  }
+  return periods;
+}
+
+// Replay the cycles of a --record file at every combination of candidate period and compute budget and
+// print a pass/fail verdict per combination. Needs neither root nor RT scheduling.
+void RunReplay(const std::string& path, const std::vector<uint64_t>& periodsMicroseconds, const std::vector<uint64_t>& budgetsMicroseconds)
+{
+  const CycleRecording recording = LoadCycleRecording(path);
+  std::cout << "Replaying " << recording.Lateness.size() << " cycles recorded at a " << recording.Period / NanoPerMicro << " us period";
+  if (recording.Dropped > 0)
+  {
+    std::cout << " (" << recording.Dropped << " cycles were dropped while recording)";
+  }
+  std::cout << "\n\n";
+
+  std::vector<uint64_t> periods;
+  for (uint64_t period : periodsMicroseconds) { periods.push_back(period * NanoPerMicro); }
+  if (periods.empty()) { periods.push_back(recording.Period); }
+  std::vector<uint64_t> budgets;
+  for (uint64_t budget : budgetsMicroseconds) { budgets.push_back(budget * NanoPerMicro); }
+  if (budgets.empty()) { budgets.push_back(0); }
+
+  std::vector<ReplayResult> results;
+  for (uint64_t period : periods)
+  {
+    for (uint64_t budget : budgets)
+    {
+      results.push_back(ReplayCycles(recording.Lateness, period, budget));
+    }
+  }
+  PrintReplayTable(std::cout, results);
+}
+
+// Run each period for the given duration and print a pass/fail verdict per rate.
+// Bucket widths always scale with the period so that the categories mean the same thing at every rate.
+void RunSweep(TestParameters params, const std::vector<uint64_t>& periodsMicroseconds, uint64_t durationSeconds,
+  ReportData& hardwareData, ReportData& softwareData)
+{
+  std::vector<RunVerdict> results;
+  for (uint64_t periodMicroseconds : periodsMicroseconds)
+  {
+    params.SendSleep = static_cast<int>(periodMicroseconds * NanoPerMicro);
+    params.BucketWidth = params.SendSleep * 0.125;
+    params.Iterations = (durationSeconds * NanoPerSec) / params.SendSleep + params.WarmupCycles();
+
+    std::cout << "Sweep period: " << periodMicroseconds << " us (" << NanoPerSec / params.SendSleep << " Hz) for "
+              << durationSeconds << " s\n\n" << std::flush;
+    RunTest(params, hardwareData, softwareData);
+    results.push_back(GetRunVerdict(std::to_string(periodMicroseconds) + "us", params));
+    if (stopRequested.load(std::memory_order_acquire)) { break; } // verdict covers the periods run so far
+  }
+  PrintSweepVerdict(std::cout, results);
+}
+
+// Drivers may reset the link when the ring sizes change
+static constexpr auto NicRingSettleTime = std::chrono::seconds(2);
+
+// Run a short NIC test at each point of a grid of coalescing and ring settings, then print the receive
+// latency per point. The NIC's original settings are restored afterward; points the driver rejects are
+// listed as such and skipped.
+void RunNicSweep(TestParameters params, const std::vector<NicSettingValues>& points, uint64_t durationSeconds,
+  ReportData& hardwareData, ReportData& softwareData)
+{
+  bool includeCoalescing = false;
+  bool includeRings = false;
+  for (const auto& [setting, value] : points.front())
+  {
+    (setting == NicSetting::RxRing || setting == NicSetting::TxRing ? includeRings : includeCoalescing) = true;
+  }
+  params.Iterations = (durationSeconds * NanoPerSec) / params.SendSleep + params.WarmupCycles();
+  params.TrackReceiveP99 = true;
+
+  ScopedNicSettings original(params.NicName, includeCoalescing, includeRings);
+  std::vector<NicSweepResult> results;
+  for (const NicSettingValues& point : points)
+  {
+    NicSweepResult result;
+    result.Setting = DescribeNicSettings(point);
+    result.BucketWidth = params.BucketWidth;
+    try
+    {
+      original.Apply(point);
+    }
+    catch (const std::exception& error)
+    {
+      result.Error = error.what();
+      results.push_back(result);
+      continue;
+    }
+    if (includeRings)
+    {
+      std::this_thread::sleep_for(NicRingSettleTime);
+    }
+
+    std::cout << "NIC sweep: " << result.Setting << " for " << durationSeconds << " s\n\n" << std::flush;
+    RunTest(params, hardwareData, softwareData);
+    const ReportData& receive = *params.ReceiveData;
+    result.Observations = receive.observations;
+    result.P99Latency = receive.p99 > receive.target ? static_cast<uint64_t>(receive.p99) - receive.target : 0;
+    result.MaxLatency = receive.max > receive.target ? receive.max - receive.target : 0;
+    results.push_back(result);
+    if (stopRequested.load(std::memory_order_acquire)) { break; } // the table covers the points run so far
+  }
+  PrintNicSweepTable(std::cout, results);
+}
+
+// Bounce a cache line between the RT CPU (--send-cpu) and every other CPU this process may use, then print
+// the round-trip latency per CPU. Runs instead of the latency test, see --cache-matrix.
+void RunCacheLineMatrix(const TestParameters& params)
+{
+  const uint64_t roundTrips = (params.Iterations != RunIndefinitely) ? params.Iterations : DefaultPingPongRoundTrips;
+  std::cout << "Bouncing a cache line " << roundTrips << " times between CPU " << params.SendCpu << " and each other CPU\n\n" << std::flush;
+  std::vector<PingPongResult> results;
+  for (int cpu : GetAllowedCpus())
+  {
+    if (cpu != params.SendCpu)
+    {
+      results.push_back(MeasureCacheLinePingPong(params.SendCpu, cpu, params.SendPriority, roundTrips));
+    }
+  }
+  PrintPingPongMatrix(std::cout, params.SendCpu, results);
+}
+
+// Wake a thread on `housekeepingCpu` from the RT CPU with each signalling mechanism, and the other way
+// around, once per period. Prints a wake latency histogram per mechanism and direction, see --signal-bench.
+void RunSignalBench(const TestParameters& params, int housekeepingCpu)
+{
+  const uint64_t wakeups = (params.Iterations != RunIndefinitely) ? params.Iterations : DefaultSignalWakeups;
+  std::cout << "Signalling " << wakeups << " times per mechanism and direction, one signal every "
+            << params.SendSleep / NanoPerMicro << " us\n\n" << std::flush;
+  for (SignalMechanism mechanism : AllSignalMechanisms)
+  {
+    for (bool fromRtCpu : { true, false })
+    {
+      const int fromCpu = fromRtCpu ? params.SendCpu : housekeepingCpu;
+      const int toCpu = fromRtCpu ? housekeepingCpu : params.SendCpu;
+      SignalBenchResult result = MeasureSignalLatency(mechanism, fromCpu, fromRtCpu ? params.SendPriority : params.ReceivePriority,
+        toCpu, fromRtCpu ? params.ReceivePriority : params.SendPriority, params.SendSleep, wakeups);
+
+      std::ostringstream label;
+      label << std::setw(7) << GetSignalMechanismName(mechanism) << " CPU " << fromCpu << " -> CPU " << toCpu
+            << (fromRtCpu ? " (RT to application)" : " (application to RT)");
+      if (!result.Error.empty())
+      {
+        std::cout << label.str() << ": failed: " << result.Error << "\n\n";
+        continue;
+      }
+      PrintHandoffHistogram(std::cout, label.str(), result.Latency);
+      std::cout << "\n" << std::flush;
+    }
+  }
+}
+
+// Run each phase of a scenario back to back on top of the command line parameters,
+// then print one combined verdict table.
+void RunScenario(const TestParameters& baseParams, const std::vector<ScenarioPhase>& phases,
+  ReportData& hardwareData, ReportData& softwareData)
+{
+  std::vector<RunVerdict> results;
+  for (size_t phaseIndex = 0; phaseIndex < phases.size(); ++phaseIndex)
+  {
+    const ScenarioPhase& phase = phases[phaseIndex];
+    TestParameters params = baseParams;
+    if (phase.PeriodMicroseconds) { params.SendSleep = static_cast<int>(*phase.PeriodMicroseconds * NanoPerMicro); }
+    if (phase.SendCpu) { params.SendCpu = *phase.SendCpu; }
+    if (phase.ReceiveCpu) { params.ReceiveCpu = *phase.ReceiveCpu; }
+    if (phase.NicName) { params.NicName = (phase.NicName->empty() || *phase.NicName == "none") ? NoNicSelected : *phase.NicName; }
+    if (phase.WarmupMilliseconds) { params.Warmup = *phase.WarmupMilliseconds * NanoPerMicro * NanoPerMicro; }
+    if (phase.Scheduler)
+    {
+      auto policy = ParseSchedulerPolicy(*phase.Scheduler);
+      if (!policy) { throw std::runtime_error("Phase \"" + phase.Name + "\": unknown scheduler \"" + *phase.Scheduler + "\""); }
+      params.Scheduler = *policy;
+    }
+    if (phase.Timer)
+    {
+      auto mechanism = ParseWakeMechanism(*phase.Timer);
+      if (!mechanism) { throw std::runtime_error("Phase \"" + phase.Name + "\": unknown timer \"" + *phase.Timer + "\""); }
+      params.Wake = *mechanism;
+    }
+    if (params.SendSleep <= 0) { throw std::runtime_error("Phase \"" + phase.Name + "\": period must be greater than zero"); }
+    params.BucketWidth = params.SendSleep * 0.125;
+    params.Iterations = (phase.DurationSeconds * NanoPerSec) / params.SendSleep + params.WarmupCycles();
+
+    std::cout << "Phase " << phaseIndex + 1 << "/" << phases.size() << ": " << phase.Name
+              << " (" << GetEstimatedRunTime(params.Iterations, params.SendSleep) << ", "
+              << params.SendSleep / NanoPerMicro << " us period"
+              << (phase.Load ? ", load: " + *phase.Load : std::string()) << ")\n\n" << std::flush;
+
+    std::optional<BackgroundLoad> load;
+    if (phase.Load)
+    {
+      load.emplace(*phase.Load);
+    }
+    RunTest(params, hardwareData, softwareData);
+    load.reset();
+
+    results.push_back(GetRunVerdict(phase.Name, params));
+    if (stopRequested.load(std::memory_order_acquire)) { break; } // verdict covers the phases run so far
+  }
+  PrintVerdictTable(std::cout, "Scenario results", results);
+
+  bool allPassed = std::all_of(results.begin(), results.end(), [](const RunVerdict& result) { return result.Passed(); });
+  std::cout << (allPassed ? "All phases passed.\n" : "One or more phases failed.\n") << std::flush;
+}
 } // end namespace Evaluator
 
 
@@ -354,15 +1315,20 @@ int main(int argc, char* argv[])
   int exitCode = 0;
   try
   {
-    static constexpr char NoNicSelected[] = "NoNicSelected";
     static constexpr int DefaultSendSleepMicroseconds = 1000;
     static constexpr int DefaultSendPriority = 42;
     static constexpr int DefaultReceivePriority = 45;
     static constexpr uint64_t AutomaticBucketWidth = 0;
+    static constexpr uint64_t DefaultSweepDurationSeconds = 10;
+    static constexpr uint64_t AutomaticDeadlineRuntime = 0;
+    static constexpr uint64_t AutomaticSnapshotThreshold = 0;
+    static constexpr uint64_t DefaultComparisonSeconds = 10;
+    static constexpr uint64_t DefaultCheckpointIntervalSeconds = 60;
+    static constexpr int NoSignalBench = -1;
     const auto DefaultCpuCore = std::max(std::thread::hardware_concurrency() - 1, 0U);
 
     Evaluator::TestParameters params;
-    params.NicName = NoNicSelected;
+    params.NicName = Evaluator::NoNicSelected;
     params.Iterations = Evaluator::RunIndefinitely;
     params.SendSleep = DefaultSendSleepMicroseconds;
     params.SendPriority = DefaultSendPriority;
@@ -371,14 +1337,43 @@ int main(int argc, char* argv[])
     params.ReceiveCpu = DefaultCpuCore;
     params.IsVerbose = false;
     params.BucketWidth = AutomaticBucketWidth;
-    Evaluator::ReportData sendData, receiveData, hardwareData, softwareData;
+    Evaluator::ReportData sendData, receiveData, hardwareData, softwareData, sendOverhead, receiveOverhead;
     params.SendData = &sendData;
     params.ReceiveData = &receiveData;
+    params.SendOverhead = &sendOverhead;
+    params.ReceiveOverhead = &receiveOverhead;
+    Evaluator::HandoffHistogram handoff;
+    params.Handoff = &handoff;
 
     bool noConfig = false;
     bool onlyConfig = false;
 
-    std::atomic<bool> liveReport = true;
+    std::string schedulerName = "fifo";
+    uint64_t deadlineRuntime = AutomaticDeadlineRuntime;
+    std::string timerName = Evaluator::GetWakeMechanismName(params.Wake);
+    std::string isolationName = Evaluator::GetWorkerIsolationName(params.Isolation);
+    std::string memoryNodeName = Evaluator::GetMemoryNodeName(params.MemoryNode);
+    std::string coalescingName = Evaluator::GetCoalescingModeName(params.Coalescing);
+    std::string nicThreadPriorityName = "keep";
+    std::string allocationGuardName = Evaluator::GetAllocationGuardModeName(
+      Evaluator::IsAllocationGuardAvailable() ? Evaluator::AllocationGuardMode::Count : Evaluator::AllocationGuardMode::Off);
+    uint64_t warmupMilliseconds = 0;
+    std::string scenarioPath;
+    std::string checkpointPath;
+    uint64_t checkpointInterval = DefaultCheckpointIntervalSeconds;
+    std::string resumePath;
+    std::string sweepPeriodList;
+    uint64_t sweepDuration = DefaultSweepDurationSeconds;
+    std::string nicSweepGrid;
+    std::string recordPath;
+    std::string replayPath;
+    std::string replayPeriodList;
+    std::string replayBudgetList;
+    bool periodicity = false;
+    std::string snapshotDirectory;
+    uint64_t snapshotThreshold = AutomaticSnapshotThreshold;
+    bool cacheMatrix = false;
+    int signalBenchCpu = NoSignalBench;
 
     std::vector<Evaluator::Argument> arguments;
     Evaluator::AddArgument(arguments, {"--nic", "-n"}, &params.NicName, "Network interface card name");
@@ -392,6 +1387,32 @@ int main(int argc, char* argv[])
     Evaluator::AddArgument(arguments, {"--no-config", "-nc"}, &noConfig, "Skip system configuration checks");
     Evaluator::AddArgument(arguments, {"--only-config", "-oc"}, &onlyConfig, "Run system configuration checks only, then exit");
     Evaluator::AddArgument(arguments, {"--bucket-width", "-b"}, &params.BucketWidth, "Bucket width in microseconds for counting occurrences (default: auto).");
+    Evaluator::AddArgument(arguments, {"--scheduler", "-sch"}, &schedulerName, "Scheduling policy of the RT threads: fifo, deadline, or compare to run both (default: fifo)");
+    Evaluator::AddArgument(arguments, {"--deadline-runtime", "-dr"}, &deadlineRuntime, "SCHED_DEADLINE runtime in microseconds per period (default: a quarter of the send sleep)");
+    Evaluator::AddArgument(arguments, {"--timer", "-t"}, &timerName, "Wake mechanism of the cyclic thread: nanosleep, timerfd, posix, spin, or compare to run each (default: nanosleep)");
+    Evaluator::AddArgument(arguments, {"--isolation", "-is"}, &isolationName, "Where the RT threads run: thread (in this process), process (separate worker process sharing only statistics), or compare to run both (default: thread)");
+    Evaluator::AddArgument(arguments, {"--coalescing", "-co"}, &coalescingName, "NIC interrupt coalescing during the test: keep, rt (no RX/TX moderation, restored afterward), or compare to run both (default: keep)");
+    Evaluator::AddArgument(arguments, {"--nic-thread-priority", "-ntp"}, &nicThreadPriorityName, "SCHED_FIFO priority of the NIC's IRQ and NAPI threads during the test: keep, auto (just below the RT threads), 1-99, or compare to run keep and auto (default: keep)");
+    Evaluator::AddArgument(arguments, {"--memory-node", "-mn"}, &memoryNodeName, "NUMA node of the RT threads' stacks, arenas and sample buffers: local (node of each RT CPU), none, a node number, or compare to run local and remote (default: local)");
+    Evaluator::AddArgument(arguments, {"--allocation-guard", "-ag"}, &allocationGuardName, "Report (count) or abort on (trap) heap allocations inside the RT loops; needs a build with RMP_EVAL_ALLOCATION_GUARD (default: count in such builds, otherwise off)");
+    Evaluator::AddArgument(arguments, {"--warmup", "-w"}, &warmupMilliseconds, "Warm-up time in milliseconds at the start of each run that is excluded from statistics (default: 0, first cycle only)");
+    Evaluator::AddArgument(arguments, {"--scenario", "-sf"}, &scenarioPath, "Run the phases of a scenario file back to back and print a combined report");
+    Evaluator::AddArgument(arguments, {"--checkpoint", "-cp"}, &checkpointPath, "Periodically save all statistics to this file so a long run can be resumed");
+    Evaluator::AddArgument(arguments, {"--checkpoint-interval", "-ci"}, &checkpointInterval, "Seconds between checkpoints (default: " + std::to_string(DefaultCheckpointIntervalSeconds) + ")");
+    Evaluator::AddArgument(arguments, {"--resume", "-r"}, &resumePath, "Continue the statistics of a checkpoint file in this run");
+    Evaluator::AddArgument(arguments, {"--periodicity", "-pd"}, &periodicity, "After each run, search the cyclic/sender latency for disturbances that repeat with a fixed period and print their periods and amplitudes");
+    Evaluator::AddArgument(arguments, {"--record", "-rec"}, &recordPath, "Write the wake lateness of every measured cycle of the cyclic/sender thread to this file for --replay");
+    Evaluator::AddArgument(arguments, {"--timerlat", "-tl"}, &params.KernelTimerlat, "Also run the kernel's timerlat tracer on the send CPU with the same period and show its IRQ and thread wake latency as rows of the table");
+    Evaluator::AddArgument(arguments, {"--snapshot", "-snap"}, &snapshotDirectory, "Trace scheduler, interrupt and hrtimer events of the RT CPUs in a tracefs instance and save a snapshot of the last events to this directory whenever a cyclic/sender cycle is later than --snapshot-threshold");
+    Evaluator::AddArgument(arguments, {"--snapshot-threshold", "-snt"}, &snapshotThreshold, "Latency in microseconds above the period that triggers a --snapshot (default: the lower bound of the worst category)");
+    Evaluator::AddArgument(arguments, {"--replay", "-rpl"}, &replayPath, "Instead of the latency test, replay the cycles of a --record file against --replay-periods and --replay-budgets and print the misses, slack and a pass/fail verdict for each");
+    Evaluator::AddArgument(arguments, {"--replay-periods", "-rpp"}, &replayPeriodList, "Comma separated candidate periods in microseconds for --replay (default: the recorded period)");
+    Evaluator::AddArgument(arguments, {"--replay-budgets", "-rpb"}, &replayBudgetList, "Comma separated compute budgets in microseconds per cycle for --replay (default: none, wake lateness only)");
+    Evaluator::AddArgument(arguments, {"--sweep-periods", "-sw"}, &sweepPeriodList, "Comma separated periods in microseconds to sweep, e.g. 2000,1000,500,250,125. Prints a pass/fail verdict per rate.");
+    Evaluator::AddArgument(arguments, {"--nic-sweep", "-nsw"}, &nicSweepGrid, "Run the NIC test at every combination of coalescing and ring settings, e.g. \"rx-usecs=0,16,64;rx-ring=64,256\", and print the receive p99/max per point. Settings are restored afterward.");
+    Evaluator::AddArgument(arguments, {"--cache-matrix", "-cm"}, &cacheMatrix, "Instead of the latency test, bounce a cache line between the send CPU and every other CPU and print the round-trip median/p99/max per CPU; --iterations sets the round trips (default: " + std::to_string(Evaluator::DefaultPingPongRoundTrips) + ")");
+    Evaluator::AddArgument(arguments, {"--signal-bench", "-sb"}, &signalBenchCpu, "Instead of the latency test, wake a thread on this housekeeping CPU from the send CPU via futex, eventfd and pipe, and back, once per --send-sleep, and print a wake latency histogram for each; --iterations sets the wakeups (default: " + std::to_string(Evaluator::DefaultSignalWakeups) + ")");
+    Evaluator::AddArgument(arguments, {"--sweep-duration", "-sd"}, &sweepDuration, "Duration in seconds of each --sweep-periods period or --nic-sweep point (default: " + std::to_string(DefaultSweepDurationSeconds) + ")");
 
     bool showHelp = false;
     Evaluator::AddArgument(arguments, {"--help", "-h"}, &showHelp, "Show this help message");
@@ -424,6 +1445,180 @@ int main(int argc, char* argv[])
       return 1;
     }
 
+    const bool compareSchedulers = (schedulerName == "compare");
+    if (!compareSchedulers)
+    {
+      auto policy = Evaluator::ParseSchedulerPolicy(schedulerName);
+      if (!policy)
+      {
+        std::cerr << "Error: unknown scheduler \"" << schedulerName << "\". Expected fifo, deadline or compare.\n";
+        return 1;
+      }
+      params.Scheduler = *policy;
+    }
+
+    const bool compareTimers = (timerName == "compare");
+    if (!compareTimers)
+    {
+      auto mechanism = Evaluator::ParseWakeMechanism(timerName);
+      if (!mechanism)
+      {
+        std::cerr << "Error: unknown timer \"" << timerName << "\". Expected nanosleep, timerfd, posix, spin or compare.\n";
+        return 1;
+      }
+      params.Wake = *mechanism;
+    }
+
+    const bool compareIsolation = (isolationName == "compare");
+    if (!compareIsolation)
+    {
+      auto isolation = Evaluator::ParseWorkerIsolation(isolationName);
+      if (!isolation)
+      {
+        std::cerr << "Error: unknown isolation \"" << isolationName << "\". Expected thread, process or compare.\n";
+        return 1;
+      }
+      params.Isolation = *isolation;
+    }
+
+    const bool compareCoalescing = (coalescingName == "compare");
+    if (!compareCoalescing)
+    {
+      auto coalescing = Evaluator::ParseCoalescingMode(coalescingName);
+      if (!coalescing)
+      {
+        std::cerr << "Error: unknown coalescing mode \"" << coalescingName << "\". Expected keep, rt or compare.\n";
+        return 1;
+      }
+      params.Coalescing = *coalescing;
+    }
+    if ((compareCoalescing || params.Coalescing != Evaluator::CoalescingMode::Keep) && params.NicName == Evaluator::NoNicSelected)
+    {
+      std::cerr << "Error: --coalescing needs a NIC, see --nic.\n";
+      return 1;
+    }
+
+    const bool compareNicThreads = (nicThreadPriorityName == "compare");
+    if (nicThreadPriorityName == "auto")
+    {
+      params.NicThreadPriority = Evaluator::GetRecommendedNicThreadPriority(params.SendPriority, params.ReceivePriority);
+    }
+    else if (nicThreadPriorityName != "keep" && !compareNicThreads)
+    {
+      size_t parsed = 0;
+      try { params.NicThreadPriority = std::stoi(nicThreadPriorityName, &parsed); } catch (...) { parsed = 0; }
+      if (parsed != nicThreadPriorityName.size() || params.NicThreadPriority < 1 || params.NicThreadPriority > 99)
+      {
+        std::cerr << "Error: invalid NIC thread priority \"" << nicThreadPriorityName << "\". Expected keep, auto, 1-99 or compare.\n";
+        return 1;
+      }
+    }
+    if ((compareNicThreads || params.NicThreadPriority != Evaluator::KeepNicThreadPriority) && params.NicName == Evaluator::NoNicSelected)
+    {
+      std::cerr << "Error: --nic-thread-priority needs a NIC, see --nic.\n";
+      return 1;
+    }
+
+    const bool compareMemoryNodes = (memoryNodeName == "compare");
+    if (!compareMemoryNodes)
+    {
+      auto memoryNode = Evaluator::ParseMemoryNode(memoryNodeName);
+      if (!memoryNode)
+      {
+        std::cerr << "Error: unknown memory node \"" << memoryNodeName << "\". Expected local, none, a node number or compare.\n";
+        return 1;
+      }
+      const std::vector<int> nodes = Evaluator::GetOnlineNumaNodes();
+      if (*memoryNode >= 0 && std::find(nodes.begin(), nodes.end(), *memoryNode) == nodes.end())
+      {
+        std::cerr << "Error: NUMA node " << *memoryNode << " is not online.\n";
+        return 1;
+      }
+      params.MemoryNode = *memoryNode;
+    }
+
+    auto allocationGuard = Evaluator::ParseAllocationGuardMode(allocationGuardName);
+    if (!allocationGuard)
+    {
+      std::cerr << "Error: unknown allocation guard mode \"" << allocationGuardName << "\". Expected off, count or trap.\n";
+      return 1;
+    }
+    if (*allocationGuard != Evaluator::AllocationGuardMode::Off && !Evaluator::IsAllocationGuardAvailable())
+    {
+      std::cerr << "Error: --allocation-guard needs a build configured with -DRMP_EVAL_ALLOCATION_GUARD=ON.\n";
+      return 1;
+    }
+    Evaluator::SetAllocationGuardMode(*allocationGuard);
+
+    std::vector<uint64_t> sweepPeriods = Evaluator::ParsePeriodList(sweepPeriodList);
+    std::vector<Evaluator::NicSettingValues> nicSweep;
+    if (!nicSweepGrid.empty())
+    {
+      nicSweep = Evaluator::ParseNicSweepGrid(nicSweepGrid);
+      if (params.NicName == Evaluator::NoNicSelected)
+      {
+        std::cerr << "Error: --nic-sweep needs a NIC, see --nic.\n";
+        return 1;
+      }
+      if (params.Coalescing != Evaluator::CoalescingMode::Keep)
+      {
+        std::cerr << "Error: --coalescing cannot be used with --nic-sweep, which sets the coalescing itself.\n";
+        return 1;
+      }
+    }
+    std::vector<Evaluator::ScenarioPhase> scenario;
+    if (!scenarioPath.empty())
+    {
+      scenario = Evaluator::LoadScenario(scenarioPath);
+    }
+    const int exclusiveModes = !sweepPeriods.empty() + !nicSweep.empty() + !scenario.empty() + compareSchedulers + compareTimers + compareIsolation + compareMemoryNodes + compareCoalescing + compareNicThreads + cacheMatrix + (signalBenchCpu != NoSignalBench) + !replayPath.empty();
+    if (exclusiveModes > 1)
+    {
+      std::cerr << "Error: only one of --sweep-periods, --nic-sweep, --scenario, --scheduler compare, --timer compare, --isolation compare, --memory-node compare, --coalescing compare, --nic-thread-priority compare, --cache-matrix, --signal-bench and --replay can be used at a time.\n";
+      return 1;
+    }
+    if (exclusiveModes > 0 && (!checkpointPath.empty() || !resumePath.empty() || !recordPath.empty() || !snapshotDirectory.empty()))
+    {
+      std::cerr << "Error: --checkpoint, --resume, --record and --snapshot only apply to a single run.\n";
+      return 1;
+    }
+    if (replayPath.empty() && (!replayPeriodList.empty() || !replayBudgetList.empty()))
+    {
+      std::cerr << "Error: --replay-periods and --replay-budgets need --replay.\n";
+      return 1;
+    }
+    if (cacheMatrix && params.Iterations == 0)
+    {
+      std::cerr << "Error: --cache-matrix needs at least one round trip; --iterations must be greater than zero.\n";
+      return 1;
+    }
+    if (!checkpointPath.empty() && checkpointInterval == 0)
+    {
+      std::cerr << "Error: --checkpoint-interval must be greater than zero.\n";
+      return 1;
+    }
+    if (!scenario.empty() && params.BucketWidth != AutomaticBucketWidth)
+    {
+      std::cerr << "Error: --bucket-width cannot be used with --scenario; buckets scale with each phase's period.\n";
+      return 1;
+    }
+    if (!sweepPeriods.empty() && params.BucketWidth != AutomaticBucketWidth)
+    {
+      std::cerr << "Error: --bucket-width cannot be used with --sweep-periods; buckets scale with each period.\n";
+      return 1;
+    }
+    if ((!sweepPeriods.empty() || !nicSweep.empty()) && sweepDuration == 0)
+    {
+      std::cerr << "Error: --sweep-duration must be greater than zero.\n";
+      return 1;
+    }
+
+    if (!replayPath.empty())
+    {
+      Evaluator::RunReplay(replayPath, Evaluator::ParsePeriodList(replayPeriodList), Evaluator::ParsePeriodList(replayBudgetList));
+      return 0;
+    }
+
     if (geteuid() != 0)
     {
       std::cerr << "Error: Not running as root. This may cause failures when accessing system configuration or opening raw sockets.\n";
@@ -432,7 +1627,7 @@ int main(int argc, char* argv[])
 
     if (!noConfig)
     {
-      Evaluator::ReportSystemConfiguration(params.SendCpu, params.NicName);
+      Evaluator::ReportSystemConfiguration(params.SendCpu, params.NicName, params.SendPriority, params.ReceivePriority);
     }
 
     // If --only-config is specified, exit after configuration checks
@@ -447,6 +1642,12 @@ int main(int argc, char* argv[])
       return 1;
     }
 
+    if (cacheMatrix)
+    {
+      Evaluator::RunCacheLineMatrix(params);
+      return 0;
+    }
+
     params.SendSleep *= Evaluator::NanoPerMicro; // convert to nanoseconds for internal use
     if (params.BucketWidth == 0)
     {
@@ -459,71 +1660,153 @@ int main(int argc, char* argv[])
 
     auto latencyFd = Evaluator::SetLatencyTarget();
 
-    Evaluator::TableMaker tableMaker = Evaluator::TableMaker::CreateTableMaker(params.BucketWidth, params.IsVerbose);
-
-    if (params.Iterations != Evaluator::RunIndefinitely)
+    if (signalBenchCpu != NoSignalBench)
     {
-      std::cout << "Estimated run time: " << Evaluator::GetEstimatedRunTime(params.Iterations, params.SendSleep) << "\n";
+      Evaluator::RunSignalBench(params, signalBenchCpu);
+      return 0;
     }
-    std::cout << "Target period: " << static_cast<int>(params.SendSleep / Evaluator::NanoPerMicro) << " us\n\n" << std::flush;
-
-    // Evaluator::DurationReporter durationReporter("Total test duration");
 
-    int lineCount = 0;
-    Evaluator::ReportVector reports;
-
-    auto startTime = std::chrono::steady_clock::now();
-
-    if (params.NicName == NoNicSelected)
+    std::optional<Evaluator::Checkpoint> resume;
+    if (!resumePath.empty())
     {
-      reports.push_back({"Cyclic", &sendData});
+      resume = Evaluator::LoadCheckpoint(resumePath);
+      if (resume->Period != static_cast<uint64_t>(params.SendSleep) || resume->BucketWidth != params.BucketWidth)
+      {
+        std::cerr << "Error: checkpoint " << resumePath << " was recorded with a " << resume->Period / Evaluator::NanoPerMicro
+                  << " us period and " << resume->BucketWidth / Evaluator::NanoPerMicro << " us bucket width; use the same settings to resume.\n";
+        return 1;
+      }
+      params.SendResume = resume->Find(params.NicName == Evaluator::NoNicSelected ? "Cyclic" : "Sender");
+      params.ReceiveResume = resume->Find("Receiver");
+      Evaluator::housekeeping.Resume = &*resume;
+      std::cout << "Resuming from " << resumePath << "\n";
+    }
+    Evaluator::housekeeping.CheckpointPath = checkpointPath;
+    Evaluator::housekeeping.CheckpointInterval = std::chrono::seconds(checkpointInterval);
+    Evaluator::FileDescriptor signalFd(Evaluator::CreateShutdownSignalFd());
+    Evaluator::housekeeping.SignalFd = signalFd.Get();
 
-      tableMaker.OptimizeRowLabelWidth(reports);
+    params.DeadlineRuntime = deadlineRuntime * Evaluator::NanoPerMicro; // convert to nanoseconds for internal use
+    params.Warmup = warmupMilliseconds * Evaluator::NanoPerMicro * Evaluator::NanoPerMicro; // convert to nanoseconds for internal use
 
-      std::thread cyclicThread(Evaluator::SenderThread, params, nullptr);
+    std::array<Evaluator::ReportData, Evaluator::CyclePhaseCount> phases;
+    if (params.IsVerbose)
+    {
+      for (size_t phase = 0; phase < phases.size(); ++phase) { params.Phases[phase] = &phases[phase]; }
+    }
 
-      std::thread reportThread(Evaluator::ReportThread, std::ref(reports), std::ref(lineCount), std::ref(tableMaker),
-        startTime, std::ref(liveReport), std::ref(std::cout));
+    std::optional<Evaluator::LatencySeries> series;
+    if (periodicity)
+    {
+      series.emplace();
+      params.Series = &*series;
+    }
 
-      cyclicThread.join();
-      testRunning.store(false, std::memory_order_release);
-      liveReport.store(false, std::memory_order_release);
-      reportThread.join();
+    std::optional<Evaluator::CycleTrace> trace;
+    if (!recordPath.empty())
+    {
+      trace.emplace(recordPath, params.SendSleep);
+      params.Trace = &*trace;
     }
-    else
+
+    std::optional<Evaluator::FtraceSnapshot> snapshot;
+    if (!snapshotDirectory.empty())
     {
-      reports.push_back({"Sender", &sendData});
-      reports.push_back({"Receiver", &receiveData});
-      if (params.IsVerbose)
+      std::vector<int> cpus = { params.SendCpu };
+      if (params.NicName != Evaluator::NoNicSelected && params.ReceiveCpu != params.SendCpu)
       {
-        reports.push_back({"HW delta", &hardwareData});
-        reports.push_back({"SW delta", &softwareData});
+        cpus.push_back(params.ReceiveCpu);
       }
+      const uint64_t threshold = (snapshotThreshold == AutomaticSnapshotThreshold)
+        ? params.BucketWidth << (Evaluator::BucketCount - 2)
+        : snapshotThreshold * Evaluator::NanoPerMicro;
+      snapshot.emplace(snapshotDirectory, cpus, threshold);
+      params.Snapshot = &*snapshot;
+      std::cout << "Tracing CPU " << params.SendCpu << (cpus.size() > 1 ? " and " + std::to_string(params.ReceiveCpu) : "")
+                << ", saving snapshots to " << snapshotDirectory << " for cycles " << threshold / Evaluator::NanoPerMicro
+                << " us or more late\n";
+    }
 
-      tableMaker.OptimizeRowLabelWidth(reports);
-
-      std::shared_ptr<Evaluator::INicTest> tester = std::make_shared<Evaluator::EthercatNicTest>(params, 
-        Evaluator::TimerReport(params.SendSleep, params.BucketWidth, &hardwareData),
-        Evaluator::TimerReport(params.SendSleep, params.BucketWidth, &softwareData));
+    if (!scenario.empty())
+    {
+      Evaluator::RunScenario(params, scenario, hardwareData, softwareData);
+      return 0;
+    }
 
-      std::thread receiverThread(Evaluator::ReceiverThread, params, tester);
-      std::thread senderThread(Evaluator::SenderThread, params, tester);
+    if (!sweepPeriods.empty())
+    {
+      Evaluator::RunSweep(params, sweepPeriods, sweepDuration, hardwareData, softwareData);
+      return 0;
+    }
 
-      std::thread reportThread(Evaluator::ReportThread, std::ref(reports), std::ref(lineCount), std::ref(tableMaker),
-        startTime, std::ref(liveReport), std::ref(std::cout));
+    if (!nicSweep.empty())
+    {
+      Evaluator::RunNicSweep(params, nicSweep, sweepDuration, hardwareData, softwareData);
+      return 0;
+    }
 
-      receiverThread.join();
-      testRunning.store(false, std::memory_order_release);
-      senderThread.join();
+    if ((compareSchedulers || compareTimers || compareIsolation || compareMemoryNodes || compareCoalescing || compareNicThreads) && params.Iterations == Evaluator::RunIndefinitely)
+    {
+      params.Iterations = (DefaultComparisonSeconds * Evaluator::NanoPerSec) / params.SendSleep + params.WarmupCycles();
+    }
 
-      liveReport.store(false, std::memory_order_release);
-      reportThread.join();
+    if (params.Iterations != Evaluator::RunIndefinitely)
+    {
+      std::cout << "Estimated run time: " << Evaluator::GetEstimatedRunTime(params.Iterations, params.SendSleep) << "\n";
     }
+    std::cout << "Target period: " << static_cast<int>(params.SendSleep / Evaluator::NanoPerMicro) << " us\n\n" << std::flush;
 
-    std::cout << std::flush;
-    Evaluator::PrintReport(reports, lineCount, tableMaker, startTime, std::chrono::steady_clock::now(), std::cout);
-    std::cout << std::flush;
+    // Evaluator::DurationReporter durationReporter("Total test duration");
 
+    if (compareSchedulers)
+    {
+      Evaluator::RunSchedulerComparison(params, hardwareData, softwareData);
+    }
+    else if (compareTimers)
+    {
+      Evaluator::RunWakeMechanismComparison(params, hardwareData, softwareData);
+    }
+    else if (compareIsolation)
+    {
+      Evaluator::RunIsolationComparison(params, hardwareData, softwareData);
+    }
+    else if (compareNicThreads)
+    {
+      Evaluator::RunNicThreadPriorityComparison(params, hardwareData, softwareData);
+    }
+    else if (compareCoalescing)
+    {
+      Evaluator::RunCoalescingComparison(params, hardwareData, softwareData);
+    }
+    else if (compareMemoryNodes)
+    {
+      Evaluator::RunMemoryNodeComparison(params, hardwareData, softwareData);
+    }
+    else
+    {
+      Evaluator::RunTest(params, hardwareData, softwareData);
+    }
+
+    if (trace)
+    {
+      trace->Close();
+      std::cout << "Recorded " << trace->Recorded() << " cycles to " << recordPath;
+      if (trace->Dropped() > 0)
+      {
+        std::cout << " (" << trace->Dropped() << " dropped, the ring was full)";
+      }
+      std::cout << "\n";
+    }
+    if (snapshot)
+    {
+      std::cout << "Saved " << snapshot->Saved() << " ftrace snapshots to " << snapshotDirectory;
+      if (snapshot->Skipped() > 0)
+      {
+        std::cout << " (" << snapshot->Skipped() << " late cycles skipped while a snapshot was being saved or after "
+                  << Evaluator::MaximumSnapshots << ")";
+      }
+      std::cout << "\n";
+    }
   }
   catch(const std::exception& error)
   {
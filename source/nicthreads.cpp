@@ -0,0 +1,192 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sched.h>
+#include <sstream>
+#include <stdexcept>
+
+#include "nictest.h"
+#include "nicthreads.h"
+
+namespace fs = std::filesystem;
+
+namespace Evaluator
+{
+  // TASK_COMM_LEN - 1
+  static constexpr size_t MaxThreadNameLength = 15;
+
+  static bool IsNameCharacter(char character)
+  {
+    return std::isalnum(static_cast<unsigned char>(character)) || character == '_';
+  }
+
+  static std::string FormatCpuSet(const cpu_set_t& cpus)
+  {
+    std::ostringstream output;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (!CPU_ISSET(cpu, &cpus)) { continue; }
+      int last = cpu;
+      while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, &cpus)) { ++last; }
+      output << (output.tellp() > 0 ? "," : "") << cpu;
+      if (last > cpu) { output << "-" << last; }
+      cpu = last;
+    }
+    return output.str();
+  }
+
+  std::set<int> ParseNicIrqs(std::string_view interrupts, std::string_view nic)
+  {
+    std::set<int> irqs;
+    std::istringstream stream{std::string(interrupts)};
+    std::string line;
+    while (std::getline(stream, line))
+    {
+      // The NIC name must stand on its own, so that eth1 doesn't match eth10 or veth1
+      bool named = false;
+      for (size_t position = line.find(nic); position != std::string::npos && !named; position = line.find(nic, position + 1))
+      {
+        const size_t end = position + nic.size();
+        named = (position == 0 || !IsNameCharacter(line[position - 1])) && (end == line.size() || !IsNameCharacter(line[end]));
+      }
+      if (!named) { continue; }
+
+      const size_t start = line.find_first_not_of(' ');
+      const size_t colon = line.find(':');
+      if (start == std::string::npos || colon == std::string::npos || colon <= start) { continue; }
+      int irq = -1;
+      auto [end, error] = std::from_chars(line.data() + start, line.data() + colon, irq);
+      if (error == std::errc() && end == line.data() + colon)
+      {
+        irqs.insert(irq);
+      }
+    }
+    return irqs;
+  }
+
+  bool IsNicKernelThread(std::string_view comm, std::string_view nic, const std::set<int>& irqs)
+  {
+    static constexpr std::string_view IrqPrefix = "irq/";
+    if (comm.starts_with(IrqPrefix))
+    {
+      int irq = -1;
+      auto [end, error] = std::from_chars(comm.data() + IrqPrefix.size(), comm.data() + comm.size(), irq);
+      return error == std::errc() && end < comm.data() + comm.size() && *end == '-' && irqs.count(irq) != 0;
+    }
+
+    std::string napiPrefix = "napi/" + std::string(nic) + "-";
+    if (comm.size() >= MaxThreadNameLength)
+    {
+      napiPrefix.resize(std::min(napiPrefix.size(), comm.size()));
+    }
+    return comm.starts_with(napiPrefix);
+  }
+
+  std::vector<NicKernelThread> FindNicKernelThreads(std::string_view nic)
+  {
+    std::ifstream interruptsFile("/proc/interrupts");
+    std::stringstream interrupts;
+    interrupts << interruptsFile.rdbuf();
+    const std::set<int> irqs = ParseNicIrqs(interrupts.str(), nic);
+
+    std::vector<NicKernelThread> threads;
+    std::error_code errorCode;
+    for (const auto& entry : fs::directory_iterator("/proc", errorCode))
+    {
+      const std::string name = entry.path().filename().string();
+      pid_t pid = 0;
+      auto [end, error] = std::from_chars(name.data(), name.data() + name.size(), pid);
+      if (error != std::errc() || end != name.data() + name.size()) { continue; }
+
+      std::string comm;
+      std::ifstream commFile(entry.path() / "comm");
+      if (!std::getline(commFile, comm) || !IsNicKernelThread(comm, nic, irqs)) { continue; }
+
+      NicKernelThread thread;
+      thread.Pid = pid;
+      thread.Name = comm;
+      thread.Policy = sched_getscheduler(pid);
+      sched_param param = {};
+      if (thread.Policy < 0 || sched_getparam(pid, &param) != 0) { continue; } // exited meanwhile
+      thread.Priority = param.sched_priority;
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      if (sched_getaffinity(pid, sizeof(cpus), &cpus) == 0)
+      {
+        thread.Cpus = FormatCpuSet(cpus);
+      }
+      threads.push_back(thread);
+    }
+    std::sort(threads.begin(), threads.end(), [](const NicKernelThread& a, const NicKernelThread& b) { return a.Name < b.Name; });
+    return threads;
+  }
+
+  std::string DescribeSchedulingPolicy(int policy, int priority)
+  {
+    switch (policy)
+    {
+      case SCHED_FIFO: return "FIFO " + std::to_string(priority);
+      case SCHED_RR: return "RR " + std::to_string(priority);
+      case SCHED_OTHER: return "OTHER";
+      case SCHED_BATCH: return "BATCH";
+      case SCHED_IDLE: return "IDLE";
+      case SCHED_DEADLINE: return "DEADLINE";
+    }
+    return "policy " + std::to_string(policy);
+  }
+
+  int GetRecommendedNicThreadPriority(int sendPriority, int receivePriority)
+  {
+    return std::max(std::min(sendPriority, receivePriority) - 1, 1);
+  }
+
+  ScopedNicThreadPriority::ScopedNicThreadPriority(std::string_view nic, int priority)
+    : original(FindNicKernelThreads(nic))
+  {
+    if (original.empty())
+    {
+      throw std::runtime_error("No IRQ or NAPI threads found for " + std::string(nic) + "; IRQs may not be threaded on this kernel.");
+    }
+    sched_param param = {};
+    param.sched_priority = priority;
+    for (const NicKernelThread& thread : original)
+    {
+      if (sched_setscheduler(thread.Pid, SCHED_FIFO, &param) != 0 && errno != ESRCH)
+      {
+        const std::string message = AppendErrorCode("Failed to set " + thread.Name + " to SCHED_FIFO " + std::to_string(priority) + ".");
+        Restore();
+        throw std::runtime_error(message);
+      }
+      ++applied;
+    }
+  }
+
+  ScopedNicThreadPriority::~ScopedNicThreadPriority()
+  {
+    Restore();
+  }
+
+  void ScopedNicThreadPriority::Restore()
+  {
+    for (size_t index = 0; index < applied; ++index)
+    {
+      const NicKernelThread& thread = original[index];
+      sched_param param = {};
+      param.sched_priority = thread.Priority;
+      if (sched_setscheduler(thread.Pid, thread.Policy, &param) != 0 && errno != ESRCH)
+      {
+        std::cerr << "WARN: failed to restore " << thread.Name << " to " << DescribeSchedulingPolicy(thread.Policy, thread.Priority)
+                  << ": " << std::strerror(errno) << "\n";
+      }
+    }
+    applied = 0;
+  }
+} // end namespace Evaluator
@@ -0,0 +1,158 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <linux/mempolicy.h>
+#include <stdexcept>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "nictest.h"
+#include "numa.h"
+
+namespace fs = std::filesystem;
+
+namespace Evaluator
+{
+  // Node masks passed to the kernel cover this many nodes, far more than any machine this runs on
+  static constexpr int MaxNumaNodes = 1024;
+  static constexpr size_t NodeMaskWords = MaxNumaNodes / (sizeof(unsigned long) * CHAR_BIT);
+
+  struct NodeMask
+  {
+    unsigned long Words[NodeMaskWords] = {};
+
+    explicit NodeMask(int node)
+    {
+      if (node < 0 || node >= MaxNumaNodes)
+      {
+        throw std::runtime_error("Invalid NUMA node " + std::to_string(node) + ".");
+      }
+      Words[node / (sizeof(unsigned long) * CHAR_BIT)] = 1UL << (node % (sizeof(unsigned long) * CHAR_BIT));
+    }
+
+    // The kernel reads one bit less than the maxnode argument
+    static constexpr unsigned long MaxNode = MaxNumaNodes + 1;
+  };
+
+  // Parse the number after `prefix` in a sysfs entry name such as "node1"
+  static std::optional<int> ParseNodeEntry(const std::string& name, std::string_view prefix)
+  {
+    if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0)
+    {
+      return std::nullopt;
+    }
+    int node = -1;
+    const char* last = name.data() + name.size();
+    auto [end, error] = std::from_chars(name.data() + prefix.size(), last, node);
+    if (error != std::errc() || end != last)
+    {
+      return std::nullopt;
+    }
+    return node;
+  }
+
+  std::string GetMemoryNodeName(int memoryNode)
+  {
+    if (memoryNode == LocalMemoryNode) { return "local"; }
+    if (memoryNode == UnboundMemoryNode) { return "none"; }
+    return std::to_string(memoryNode);
+  }
+
+  std::optional<int> ParseMemoryNode(std::string_view name)
+  {
+    if (name == "local") { return LocalMemoryNode; }
+    if (name == "none") { return UnboundMemoryNode; }
+    int node = -1;
+    auto [end, error] = std::from_chars(name.data(), name.data() + name.size(), node);
+    if (error != std::errc() || end != name.data() + name.size() || node < 0 || node >= MaxNumaNodes)
+    {
+      return std::nullopt;
+    }
+    return node;
+  }
+
+  std::vector<int> GetOnlineNumaNodes()
+  {
+    std::vector<int> nodes;
+    std::error_code errorCode;
+    for (const auto& entry : fs::directory_iterator("/sys/devices/system/node", errorCode))
+    {
+      if (auto node = ParseNodeEntry(entry.path().filename().string(), "node"))
+      {
+        nodes.push_back(*node);
+      }
+    }
+    std::sort(nodes.begin(), nodes.end());
+    return nodes;
+  }
+
+  std::optional<int> GetCpuNumaNode(int cpu)
+  {
+    std::error_code errorCode;
+    for (const auto& entry : fs::directory_iterator("/sys/devices/system/cpu/cpu" + std::to_string(cpu), errorCode))
+    {
+      if (auto node = ParseNodeEntry(entry.path().filename().string(), "node"))
+      {
+        return node;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::optional<int> GetNicNumaNode(std::string_view nic)
+  {
+    std::ifstream file("/sys/class/net/" + std::string(nic) + "/device/numa_node");
+    int node = -1;
+    if (!(file >> node) || node < 0)
+    {
+      return std::nullopt;
+    }
+    return node;
+  }
+
+  int ResolveMemoryNode(int memoryNode, int cpu)
+  {
+    if (memoryNode != LocalMemoryNode)
+    {
+      return memoryNode;
+    }
+    return GetCpuNumaNode(cpu).value_or(UnboundMemoryNode);
+  }
+
+  void BindMemoryToNode(void* address, size_t length, int node)
+  {
+    NodeMask mask(node);
+    if (syscall(SYS_mbind, address, length, MPOL_BIND, mask.Words, NodeMask::MaxNode, MPOL_MF_MOVE) != 0)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to bind RT memory to NUMA node " + std::to_string(node) + "."));
+    }
+  }
+
+  ScopedMemoryNode::ScopedMemoryNode(int node)
+  {
+    if (node == UnboundMemoryNode)
+    {
+      return;
+    }
+    // Preferred rather than bound so that an allocation made in this scope falls back instead of failing
+    NodeMask mask(node);
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.Words, NodeMask::MaxNode) != 0)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to set the memory policy to NUMA node " + std::to_string(node) + "."));
+    }
+    active = true;
+  }
+
+  ScopedMemoryNode::~ScopedMemoryNode()
+  {
+    if (active)
+    {
+      syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0UL);
+    }
+  }
+} // end namespace Evaluator
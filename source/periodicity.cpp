@@ -0,0 +1,316 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <numbers>
+#include <numeric>
+#include <stdexcept>
+#include <sys/mman.h>
+
+#include "nictest.h"
+#include "numa.h"
+#include "periodicity.h"
+#include "reporter.h"
+
+namespace Evaluator
+{
+  static constexpr size_t MinimumLag = 3;              // windows; shorter periods vanish inside a window
+  static constexpr size_t MinimumRepeats = 3;          // a period must fit this many times into the series
+  static constexpr double MinimumCorrelation = 0.2;
+  static constexpr double MinimumProminence = 0.1;     // above the lowest correlation between half the lag and the lag
+  static constexpr double MinimumRepeatCorrelation = 0.5; // of the correlation at the lag, at twice the lag
+  static constexpr size_t MaxComponents = 3;
+  static constexpr double SpikeTolerance = 2;          // windows a spike interval may be off a whole number of periods
+  static constexpr size_t SpikePartners = 8;           // later spikes searched for a whole number of periods
+  static constexpr uint64_t MinimumMatchedSpikes = 2;
+
+  LatencySeries::LatencySeries(size_t windowCapacity, size_t spikeCapacity)
+    : windowMask(std::bit_ceil(std::max<size_t>(windowCapacity, 2)) - 1)
+    , spikeMask(std::bit_ceil(std::max<size_t>(spikeCapacity, 2)) - 1)
+  {
+    static_assert(sizeof(State) % alignof(Slot) == 0 && sizeof(Slot) % alignof(uint64_t) == 0);
+    mappingSize = sizeof(State) + (windowMask + 1) * sizeof(Slot) + (spikeMask + 1) * sizeof(uint64_t);
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to allocate the latency series."));
+    }
+    state = new (mapping) State();
+    slots = reinterpret_cast<Slot*>(static_cast<char*>(mapping) + sizeof(State));
+    spikeTimes = reinterpret_cast<uint64_t*>(slots + windowMask + 1);
+  }
+
+  LatencySeries::~LatencySeries()
+  {
+    munmap(state, mappingSize);
+  }
+
+  void LatencySeries::BindToNode(int node)
+  {
+    BindMemoryToNode(state, mappingSize, node);
+  }
+
+  void LatencySeries::Reset(uint64_t window, uint64_t spikeThreshold)
+  {
+    *state = State();
+    state->Window = std::max<uint64_t>(window, 1);
+    state->SpikeThreshold = spikeThreshold;
+    std::memset(static_cast<void*>(slots), 0, (windowMask + 1) * sizeof(Slot));
+  }
+
+  void LatencySeries::Add(uint64_t time, uint64_t latency) noexcept
+  {
+    if (state->Start == 0) { state->Start = time; }
+    const uint64_t window = (time - state->Start) / state->Window;
+    Slot& slot = slots[window & windowMask];
+    if (slot.Window != window + 1)
+    {
+      slot.Window = window + 1;
+      slot.Max = latency;
+    }
+    else if (latency > slot.Max)
+    {
+      slot.Max = latency;
+    }
+    state->LastWindow = window;
+
+    if (latency >= state->SpikeThreshold)
+    {
+      spikeTimes[state->Spikes++ & spikeMask] = time;
+    }
+  }
+
+  std::vector<uint64_t> LatencySeries::GetWindows() const
+  {
+    std::vector<uint64_t> windows;
+    if (state->Start == 0) { return windows; }
+    const uint64_t count = std::min<uint64_t>(state->LastWindow + 1, windowMask + 1);
+    for (uint64_t window = state->LastWindow + 1 - count; window <= state->LastWindow; ++window)
+    {
+      const Slot& slot = slots[window & windowMask];
+      windows.push_back(slot.Window == window + 1 ? slot.Max : 0);
+    }
+    return windows;
+  }
+
+  std::vector<uint64_t> LatencySeries::GetSpikeTimes() const
+  {
+    std::vector<uint64_t> times;
+    const uint64_t count = std::min<uint64_t>(state->Spikes, spikeMask + 1);
+    for (uint64_t spike = state->Spikes - count; spike < state->Spikes; ++spike)
+    {
+      times.push_back(spikeTimes[spike & spikeMask]);
+    }
+    return times;
+  }
+
+  // In-place iterative radix-2 FFT; the size must be a power of two
+  static void TransformFourier(std::vector<std::complex<double>>& data, bool inverse)
+  {
+    const size_t size = data.size();
+    for (size_t index = 1, reversed = 0; index < size; ++index)
+    {
+      size_t bit = size >> 1;
+      for (; reversed & bit; bit >>= 1) { reversed ^= bit; }
+      reversed ^= bit;
+      if (index < reversed) { std::swap(data[index], data[reversed]); }
+    }
+    for (size_t length = 2; length <= size; length <<= 1)
+    {
+      const double angle = (inverse ? 2 : -2) * std::numbers::pi / static_cast<double>(length);
+      const std::complex<double> step(std::cos(angle), std::sin(angle));
+      for (size_t start = 0; start < size; start += length)
+      {
+        std::complex<double> twiddle(1);
+        for (size_t offset = 0; offset < length / 2; ++offset)
+        {
+          const std::complex<double> even = data[start + offset];
+          const std::complex<double> odd = data[start + offset + length / 2] * twiddle;
+          data[start + offset] = even + odd;
+          data[start + offset + length / 2] = even - odd;
+          twiddle *= step;
+        }
+      }
+    }
+  }
+
+  // Unbiased autocorrelation of a zero-mean series for lags 0..maxLag, normalized to 1 at lag 0, through
+  // the power spectrum. Zero padding to twice the length keeps the correlation from wrapping around.
+  static std::vector<double> GetAutocorrelation(const std::vector<double>& series, size_t maxLag)
+  {
+    std::vector<std::complex<double>> spectrum(std::bit_ceil(2 * series.size()));
+    std::copy(series.begin(), series.end(), spectrum.begin());
+    TransformFourier(spectrum, false);
+    for (auto& value : spectrum) { value = std::norm(value); }
+    TransformFourier(spectrum, true);
+
+    const double size = static_cast<double>(series.size());
+    const double variance = spectrum[0].real() / size;
+    std::vector<double> correlation(maxLag + 1, 0.0);
+    if (variance <= 0) { return correlation; }
+    for (size_t lag = 0; lag <= maxLag; ++lag)
+    {
+      correlation[lag] = spectrum[lag].real() / (size - static_cast<double>(lag)) / variance;
+    }
+    return correlation;
+  }
+
+  // Mean series value at each phase of `period` windows, highest phase minus the median of the series
+  static uint64_t GetFoldedAmplitude(const std::vector<uint64_t>& windows, size_t period, uint64_t median)
+  {
+    std::vector<double> sums(period, 0.0);
+    std::vector<uint64_t> counts(period, 0);
+    for (size_t index = 0; index < windows.size(); ++index)
+    {
+      sums[index % period] += static_cast<double>(windows[index]);
+      ++counts[index % period];
+    }
+    double peak = 0;
+    for (size_t phase = 0; phase < period; ++phase)
+    {
+      if (counts[phase] > 0) { peak = std::max(peak, sums[phase] / static_cast<double>(counts[phase])); }
+    }
+    return peak > static_cast<double>(median) ? static_cast<uint64_t>(peak) - median : 0;
+  }
+
+  // Period as the total time over the total number of periods of the spike intervals that are within a
+  // couple of windows of a whole number of periods. Each spike is paired with the first of the next few
+  // spikes that is.
+  static double RefinePeriodFromSpikes(const std::vector<uint64_t>& spikeTimes, double period, double window, uint64_t& matched)
+  {
+    double totalTime = 0;
+    double totalPeriods = 0;
+    matched = 0;
+    for (size_t first = 0; first < spikeTimes.size(); ++first)
+    {
+      for (size_t second = first + 1; second < std::min(spikeTimes.size(), first + 1 + SpikePartners); ++second)
+      {
+        const double interval = static_cast<double>(spikeTimes[second] - spikeTimes[first]);
+        const double periods = std::round(interval / period);
+        if (periods >= 1 && std::abs(interval - periods * period) <= SpikeTolerance * window)
+        {
+          totalTime += interval;
+          totalPeriods += periods;
+          ++matched;
+          break;
+        }
+      }
+    }
+    return matched >= MinimumMatchedSpikes ? totalTime / totalPeriods : period;
+  }
+
+  // Shortest lag that is a clear local maximum of the autocorrelation, 0 if there is none. The shortest
+  // rather than the strongest, since every multiple of a period correlates about as well as the period.
+  // Where twice the lag is in range it has to correlate too: two unrelated disturbances at a fixed offset
+  // also produce a peak at that offset, but not at twice of it.
+  static size_t FindShortestPeriod(const std::vector<double>& correlation)
+  {
+    for (size_t lag = MinimumLag; lag + 1 < correlation.size(); ++lag)
+    {
+      const double value = correlation[lag];
+      if (value < MinimumCorrelation || value <= correlation[lag - 1] || value < correlation[lag + 1]) { continue; }
+      const double valley = *std::min_element(correlation.begin() + lag / 2, correlation.begin() + lag);
+      if (value - valley < MinimumProminence) { continue; }
+      if (2 * lag + 1 < correlation.size())
+      {
+        const double repeat = *std::max_element(correlation.begin() + 2 * lag - 1, correlation.begin() + 2 * lag + 2);
+        if (repeat < MinimumRepeatCorrelation * value) { continue; }
+      }
+      return lag;
+    }
+    return 0;
+  }
+
+  std::vector<PeriodicComponent> FindPeriodicComponents(const std::vector<uint64_t>& windows, uint64_t window,
+    const std::vector<uint64_t>& spikeTimes)
+  {
+    std::vector<PeriodicComponent> components;
+    const size_t maxLag = windows.size() / MinimumRepeats;
+    if (maxLag <= MinimumLag + 1) { return components; }
+
+    std::vector<uint64_t> sorted = windows;
+    std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+    const uint64_t median = sorted[sorted.size() / 2];
+
+    const double mean = std::accumulate(windows.begin(), windows.end(), 0.0) / static_cast<double>(windows.size());
+    std::vector<double> residual(windows.size());
+    std::transform(windows.begin(), windows.end(), residual.begin(), [mean](uint64_t value) { return static_cast<double>(value) - mean; });
+
+    std::vector<size_t> lags;
+
+    // Find the shortest period, subtract its mean profile and look again, so that a second disturbance is
+    // found even if its period is a multiple of the first and cross terms between the two don't show up
+    while (components.size() < MaxComponents)
+    {
+      const std::vector<double> correlation = GetAutocorrelation(residual, maxLag);
+      const size_t lag = FindShortestPeriod(correlation);
+      if (lag == 0 || std::any_of(lags.begin(), lags.end(), [lag](size_t found) { return found == lag; })) { break; }
+      lags.push_back(lag);
+
+      // Parabolic interpolation between the neighboring lags places the peak to a fraction of a window
+      const double previous = correlation[lag - 1];
+      const double next = correlation[lag + 1];
+      const double curvature = previous - 2 * correlation[lag] + next;
+      const double offset = curvature < 0 ? 0.5 * (previous - next) / curvature : 0;
+
+      PeriodicComponent component;
+      component.Correlation = correlation[lag];
+      component.Amplitude = GetFoldedAmplitude(windows, lag, median);
+      const double period = (static_cast<double>(lag) + offset) * static_cast<double>(window);
+      component.PeriodSeconds = RefinePeriodFromSpikes(spikeTimes, period, static_cast<double>(window), component.MatchedSpikes) / NanoPerSec;
+      components.push_back(component);
+
+      std::vector<double> profile(lag, 0.0);
+      std::vector<uint64_t> counts(lag, 0);
+      for (size_t index = 0; index < residual.size(); ++index)
+      {
+        profile[index % lag] += residual[index];
+        ++counts[index % lag];
+      }
+      for (size_t index = 0; index < residual.size(); ++index)
+      {
+        residual[index] -= profile[index % lag] / static_cast<double>(counts[index % lag]);
+      }
+    }
+
+    std::sort(components.begin(), components.end(), [](const auto& left, const auto& right) { return left.Correlation > right.Correlation; });
+    return components;
+  }
+
+  void PrintPeriodicity(std::ostream& stream, std::string_view label, const LatencySeries& series)
+  {
+    const std::vector<uint64_t> windows = series.GetWindows();
+    if (windows.empty()) { return; }
+
+    const double seconds = static_cast<double>(windows.size() * series.Window()) / NanoPerSec;
+    stream << label << " periodicity over the last " << std::fixed << std::setprecision(0) << seconds << " s in "
+           << series.Window() / 1'000'000 << " ms windows, " << series.SpikeCount() << " cycles >= "
+           << static_cast<uint64_t>(series.SpikeThreshold() * NanoToMicro) << "us late";
+    const std::vector<PeriodicComponent> components = FindPeriodicComponents(windows, series.Window(), series.GetSpikeTimes());
+    if (components.empty())
+    {
+      stream << ": no periodic disturbance found.\n" << std::defaultfloat;
+      return;
+    }
+
+    stream << ":\n";
+    for (const PeriodicComponent& component : components)
+    {
+      stream << "  every " << std::setprecision(3) << component.PeriodSeconds << " s: "
+             << static_cast<uint64_t>(component.Amplitude * NanoToMicro) << "us above the median, correlation "
+             << std::setprecision(2) << component.Correlation;
+      if (component.MatchedSpikes > 0)
+      {
+        stream << ", " << component.MatchedSpikes << " spike intervals fit it";
+      }
+      stream << "\n";
+    }
+    stream << std::defaultfloat;
+  }
+} // end namespace Evaluator
@@ -0,0 +1,269 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <memory_resource>
+#include <optional>
+#include <sched.h>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "pingpong.h"
+#include "reporter.h"
+#include "rtthread.h"
+
+namespace Evaluator
+{
+  static constexpr size_t CacheLineSize = 64;
+  static constexpr uint64_t PingPongWarmupTrips = 1000;        // untimed, to bring both threads and the line up to speed
+  static constexpr uint64_t PingPongTimeout = NanoPerSec;      // a partner that doesn't answer within this is not running
+  static constexpr uint64_t SpinsPerTimeoutCheck = 1 << 12;
+  static constexpr int ClockCalibrationReads = 1000;
+
+  // The bounced line, with the abort flag on a line of its own so that checking it adds no traffic
+  struct PingPongLine
+  {
+    alignas(CacheLineSize) std::atomic<uint64_t> turn = 0;
+    alignas(CacheLineSize) std::atomic_bool abort = false;
+  };
+
+  // Spin until the line holds `value`. False if the other side gave up or didn't answer in time.
+  static bool WaitForTurn(PingPongLine& line, uint64_t value)
+  {
+    uint64_t deadline = 0;
+    for (uint64_t spins = 1; line.turn.load(std::memory_order_acquire) != value; ++spins)
+    {
+      if (spins % SpinsPerTimeoutCheck != 0) { continue; }
+      const uint64_t now = GetCurrentTime();
+      if (deadline == 0) { deadline = now + PingPongTimeout; }
+      if (line.abort.load(std::memory_order_relaxed) || now > deadline)
+      {
+        line.abort.store(true, std::memory_order_relaxed);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Cheapest of many back-to-back clock reads, subtracted from each timed round trip
+  static uint64_t GetClockOverhead()
+  {
+    uint64_t overhead = UINT64_MAX;
+    for (int read = 0; read < ClockCalibrationReads; ++read)
+    {
+      const uint64_t start = GetCurrentTime();
+      overhead = std::min(overhead, GetCurrentTime() - start);
+    }
+    return overhead;
+  }
+
+  static std::optional<std::string> ReadFirstLine(const std::string& path)
+  {
+    std::ifstream file(path);
+    std::string line;
+    if (!std::getline(file, line)) { return std::nullopt; }
+    return line;
+  }
+
+  static std::optional<std::string> ReadCpuTopology(int cpu, const char* entry)
+  {
+    return ReadFirstLine("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + entry);
+  }
+
+  // True if a CPU list such as "0-7,16" contains `cpu`
+  static bool CpuListContains(const std::string& list, int cpu)
+  {
+    std::istringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ','))
+    {
+      int first = -1;
+      int last = -1;
+      const size_t dash = range.find('-');
+      try
+      {
+        first = std::stoi(range.substr(0, dash));
+        last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+      }
+      catch (...) { continue; }
+      if (cpu >= first && cpu <= last) { return true; }
+    }
+    return false;
+  }
+
+  // Hybrid Intel CPUs register one perf PMU per core type
+  static const char* GetCoreType(int cpu)
+  {
+    if (auto list = ReadFirstLine("/sys/devices/cpu_core/cpus"); list && CpuListContains(*list, cpu)) { return "P-core"; }
+    if (auto list = ReadFirstLine("/sys/devices/cpu_atom/cpus"); list && CpuListContains(*list, cpu)) { return "E-core"; }
+    return nullptr;
+  }
+
+  std::vector<int> GetAllowedCpus()
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    std::vector<int> allowed;
+    if (sched_getaffinity(0, sizeof(cpus), &cpus) != 0)
+    {
+      return allowed;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (CPU_ISSET(cpu, &cpus)) { allowed.push_back(cpu); }
+    }
+    return allowed;
+  }
+
+  std::string DescribeCpuRelation(int rtCpu, int cpu)
+  {
+    std::string relation = "unknown topology";
+    auto rtPackage = ReadCpuTopology(rtCpu, "physical_package_id");
+    auto package = ReadCpuTopology(cpu, "physical_package_id");
+    if (rtPackage && package)
+    {
+      if (*rtPackage != *package)
+      {
+        relation = "other package";
+      }
+      else
+      {
+        auto rtCore = ReadCpuTopology(rtCpu, "core_id");
+        auto core = ReadCpuTopology(cpu, "core_id");
+        relation = (rtCore && core && *rtCore == *core) ? "SMT sibling" : "same package";
+      }
+    }
+    if (const char* type = GetCoreType(cpu))
+    {
+      relation += std::string(", ") + type;
+    }
+    return relation;
+  }
+
+  PingPongResult MeasureCacheLinePingPong(int rtCpu, int cpu, int priority, uint64_t roundTrips)
+  {
+    PingPongResult result;
+    result.Cpu = cpu;
+    result.Relation = DescribeCpuRelation(rtCpu, cpu);
+    if (roundTrips == 0)
+    {
+      result.Error = "no round trips requested";
+      return result;
+    }
+
+    const uint64_t totalTrips = PingPongWarmupTrips + roundTrips;
+    PingPongLine line;
+    uint64_t completed = 0;
+
+    RtThreadAttributes attributes;
+    attributes.Priority = priority;
+    try
+    {
+      attributes.Cpu = cpu;
+      RtThread partner(attributes, [&line, totalTrips]
+      {
+        for (uint64_t trip = 0; trip < totalTrips; ++trip)
+        {
+          if (!WaitForTurn(line, 2 * trip + 1)) { return; }
+          line.turn.store(2 * trip + 2, std::memory_order_release);
+        }
+      });
+
+      try
+      {
+        // The samples live in the RT side's arena, on its CPU's node, and are reduced before the arena goes away
+        attributes.Cpu = rtCpu;
+        attributes.ArenaSize = roundTrips * sizeof(uint64_t) + alignof(std::max_align_t);
+        RtThread rtSide(attributes, [&line, &result, &completed, roundTrips, totalTrips]
+        {
+          std::pmr::vector<uint64_t> samples(roundTrips, RtArena::ForThisThread());
+          const uint64_t clockOverhead = GetClockOverhead();
+          for (uint64_t trip = 0; trip < totalTrips; ++trip)
+          {
+            const uint64_t start = GetCurrentTime();
+            line.turn.store(2 * trip + 1, std::memory_order_release);
+            if (!WaitForTurn(line, 2 * trip + 2)) { return; }
+            const uint64_t elapsed = GetCurrentTime() - start;
+            if (trip >= PingPongWarmupTrips)
+            {
+              samples[completed++] = elapsed > clockOverhead ? elapsed - clockOverhead : 0;
+            }
+          }
+          if (completed < roundTrips) { return; }
+
+          auto quantile = [&samples](double fraction)
+          {
+            auto position = samples.begin() + static_cast<ptrdiff_t>(fraction * static_cast<double>(samples.size() - 1));
+            std::nth_element(samples.begin(), position, samples.end());
+            return *position;
+          };
+          result.Median = quantile(0.50);
+          result.P99 = quantile(0.99);
+          result.Max = *std::max_element(samples.begin(), samples.end());
+        });
+        rtSide.Join();
+      }
+      catch (...)
+      {
+        line.abort.store(true, std::memory_order_relaxed);
+        throw;
+      }
+      partner.Join();
+    }
+    catch (const std::exception& error)
+    {
+      result.Error = error.what();
+      return result;
+    }
+
+    if (completed < roundTrips)
+    {
+      result.Error = "CPU " + std::to_string(cpu) + " stopped answering after " + std::to_string(completed) + " round trips";
+      return result;
+    }
+
+    result.RoundTrips = completed;
+    return result;
+  }
+
+  void PrintPingPongMatrix(std::ostream& stream, int rtCpu, const std::vector<PingPongResult>& results)
+  {
+    static constexpr int ColumnWidth = 10;
+    stream << "Cache-line round trip from CPU " << rtCpu << " in ns:\n"
+           << std::setw(6) << "CPU" << " | " << std::setw(ColumnWidth) << "Median" << " | " << std::setw(ColumnWidth) << "P99"
+           << " | " << std::setw(ColumnWidth) << "Max" << " | Relation\n";
+    if (results.empty())
+    {
+      stream << "No other CPU is available to this process.\n";
+      return;
+    }
+
+    const PingPongResult* best = nullptr;
+    for (const PingPongResult& result : results)
+    {
+      if (result.Error.empty() && (best == nullptr || result.Median < best->Median)) { best = &result; }
+    }
+    for (const PingPongResult& result : results)
+    {
+      stream << std::setw(6) << result.Cpu << " | ";
+      if (!result.Error.empty())
+      {
+        stream << "failed: " << result.Error << "\n";
+        continue;
+      }
+      const char* color = (&result == best) ? BucketColorScheme::GetColor(0) : "";
+      stream << color << std::setw(ColumnWidth) << result.Median << (*color ? BucketColorScheme::GetResetColor() : "")
+             << " | " << std::setw(ColumnWidth) << result.P99 << " | " << std::setw(ColumnWidth) << result.Max
+             << " | " << result.Relation << "\n";
+    }
+    if (best != nullptr)
+    {
+      stream << "Lowest median: CPU " << best->Cpu << " (" << best->Relation << "), " << best->Median << " ns per round trip.\n";
+    }
+  }
+} // end namespace Evaluator
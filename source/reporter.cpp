@@ -1,12 +1,19 @@
 // Copyright (c) 2025 Robotic Systems Integration, Inc.
 // Licensed under the MIT License. See LICENSE file in the project root for details.
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <bit>
+#include <cstddef>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -104,14 +111,53 @@ namespace Evaluator
     ValueFormatter(stream, ValueGetter(data), Width);
   }
 
-  static size_t GetBucketIndex(uint64_t element, uint64_t bucketWidth, size_t bucketCount)
+  size_t GetBucketIndex(uint64_t element, uint64_t bucketWidth, size_t bucketCount)
   {
     size_t deviations = element / bucketWidth;
     size_t bucketIndex = std::bit_width(deviations);
     return std::min(bucketIndex, bucketCount - 1);
   }
 
-  static constexpr double NanoToMicro = 0.001;
+  // Everything after the sequence counter, copied as raw bytes so that the counter is only touched atomically
+  static constexpr size_t ReportPayloadOffset = offsetof(ReportData, min);
+  static_assert(std::is_trivially_copyable_v<ReportData> && offsetof(ReportData, sequence) == 0);
+
+  static void CopyReportPayload(ReportData& destination, const ReportData& source) noexcept
+  {
+    std::memcpy(reinterpret_cast<char*>(&destination) + ReportPayloadOffset,
+      reinterpret_cast<const char*>(&source) + ReportPayloadOffset, sizeof(ReportData) - ReportPayloadOffset);
+  }
+
+  void PublishReportData(ReportData& upload, const ReportData& data) noexcept
+  {
+    std::atomic_ref<uint64_t> sequence(upload.sequence);
+    const uint64_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    CopyReportPayload(upload, data);
+    sequence.store(start + 2, std::memory_order_release);
+  }
+
+  ReportData ReadReportData(const ReportData& upload) noexcept
+  {
+    std::atomic_ref<uint64_t> sequence(const_cast<uint64_t&>(upload.sequence));
+    ReportData copy;
+    while (true)
+    {
+      const uint64_t before = sequence.load(std::memory_order_acquire);
+      if ((before & 1) == 0)
+      {
+        CopyReportPayload(copy, upload);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before)
+        {
+          return copy;
+        }
+      }
+      // The writer may be preempted, or share this CPU
+      std::this_thread::yield();
+    }
+  }
 
   TableMaker TableMaker::CreateTableMaker(uint64_t bucketWidth, bool isVerbose)
   {
@@ -445,10 +491,154 @@ namespace Evaluator
            << BucketColorScheme::GetResetColor() << ".\n";
   }
 
+  int TableMaker::PrintPageFaultSummary(std::ostream& stream, std::string_view label, const ReportData& data) const
+  {
+    if (!data.pageFaultsMeasured)
+    {
+      return 0;
+    }
+
+    const bool faulted = (data.minorPageFaults + data.majorPageFaults) > 0;
+    const char* color = faulted ? BucketColorScheme::GetColor(BucketCount - 1) : BucketColorScheme::GetColor(0);
+    stream << std::setw(rowLabelWidth) << label << " page faults: "
+           << color << data.minorPageFaults << " minor, " << data.majorPageFaults << " major" << BucketColorScheme::GetResetColor()
+           << (faulted ? " during measurement. The RT path touched memory that was not resident.\n" : ".\n");
+    return 1;
+  }
+
+  int TableMaker::PrintOverheadSummary(std::ostream& stream, std::string_view label, const ReportData& data) const
+  {
+    if (data.observations == 0)
+    {
+      return 0;
+    }
+
+    const double mean = static_cast<double>(data.sum) / static_cast<double>(data.observations);
+    const bool excessive = !data.isPhase && mean > bucketWidth * OverheadWarningFraction;
+    const char* color = excessive ? BucketColorScheme::GetColor(BucketCount - 1) : BucketColorScheme::GetColor(0);
+    stream << std::setw(rowLabelWidth) << label << ": " << color << "mean " << std::fixed << std::setprecision(2)
+           << mean * NanoToMicro << "us, max " << data.max * NanoToMicro << "us" << std::defaultfloat
+           << BucketColorScheme::GetResetColor() << " at index " << data.maxIndex;
+    if (excessive)
+    {
+      stream << ". WARNING: more than " << static_cast<int>(OverheadWarningFraction * 100)
+             << "% of the bucket width is spent measuring.\n";
+    }
+    else
+    {
+      stream << ".\n";
+    }
+    return 1;
+  }
+
+  OverheadReport::OverheadReport(uint64_t argBucketWidth, ReportData* argUpload, bool argIsPhase)
+    : bucketWidth(argBucketWidth)
+    , uploadLocation(argUpload)
+    , isPhase(argIsPhase)
+  {}
+
+  void OverheadReport::AddObservation(uint64_t nanoseconds, int index)
+  {
+    observations++;
+    sum += nanoseconds;
+    if (nanoseconds < min)
+    {
+      min = nanoseconds;
+      minIndex = index;
+    }
+    if (nanoseconds > max)
+    {
+      max = nanoseconds;
+      maxIndex = index;
+    }
+    ++buckets[GetBucketIndex(nanoseconds, bucketWidth, BucketCount)];
+
+    if (uploadLocation != nullptr)
+    {
+      PublishReportData(*uploadLocation, Snapshot());
+    }
+  }
+
+  ReportData OverheadReport::Snapshot() const
+  {
+    ReportData data;
+    data.min = min;
+    data.max = max;
+    data.sum = sum;
+    data.minIndex = minIndex;
+    data.maxIndex = maxIndex;
+    data.observations = observations;
+    data.median = observations > 0 ? static_cast<double>(sum) / static_cast<double>(observations) : 0.0;
+    data.target = 0;
+    data.bucketWidth = bucketWidth;
+    std::memcpy(data.buckets, buckets, sizeof(buckets));
+    data.isOverhead = true;
+    data.isPhase = isPhase;
+    return data;
+  }
+
+  void HandoffHistogram::AddObservation(uint64_t nanoseconds, int index)
+  {
+    ++bins[GetBucketIndex(nanoseconds, HandoffBinWidth, HandoffBinCount)];
+    ++observations;
+    sum += nanoseconds;
+    if (nanoseconds > max)
+    {
+      max = nanoseconds;
+      maxIndex = index;
+    }
+  }
+
+  void PrintHandoffHistogram(std::ostream& stream, std::string_view label, const HandoffHistogram& data)
+  {
+    static constexpr int BarWidth = 40;
+    stream << label << ": ";
+    if (data.observations == 0)
+    {
+      stream << "no handoffs where the sender waited";
+      if (data.unblocked > 0)
+      {
+        stream << ", the receiver was ready first in all " << data.unblocked << " cycles";
+      }
+      stream << ".\n";
+      return;
+    }
+    const double mean = static_cast<double>(data.sum) / static_cast<double>(data.observations);
+    stream << data.observations << " handoffs, mean " << std::fixed << std::setprecision(2) << mean * NanoToMicro
+           << "us, max " << data.max * NanoToMicro << "us" << std::defaultfloat << " at index " << data.maxIndex << "\n";
+
+    size_t first = 0;
+    size_t last = HandoffBinCount - 1;
+    while (data.bins[first] == 0) { ++first; }
+    while (data.bins[last] == 0) { --last; }
+    const uint64_t largest = *std::max_element(std::begin(data.bins), std::end(data.bins));
+    for (size_t bin = first; bin <= last; ++bin)
+    {
+      // Bin 0 is [0, w), bin i is [w * 2^(i-1), w * 2^i), the last bin is open-ended
+      std::ostringstream range;
+      const uint64_t lower = bin == 0 ? 0 : HandoffBinWidth << (bin - 1);
+      if (bin == HandoffBinCount - 1)
+      {
+        range << ">= " << lower * NanoToMicro << "us";
+      }
+      else
+      {
+        range << lower * NanoToMicro << "-" << (HandoffBinWidth << bin) * NanoToMicro << "us";
+      }
+      const int bar = static_cast<int>((data.bins[bin] * BarWidth + largest - 1) / largest);
+      stream << std::setw(14) << range.str() << " | " << std::setw(10) << data.bins[bin] << " " << std::string(bar, '#') << "\n";
+    }
+    if (data.unblocked > 0)
+    {
+      stream << data.unblocked << " cycles found the receiver ready without waiting and are not counted.\n";
+    }
+  }
+
   TimerReport::TimerReport(uint64_t argTarget, uint64_t argBucketWidth, ReportData* argUpload)
     : uploadLocation(argUpload)
     , target(argTarget)
     , bucketWidth(argBucketWidth)
+    , blockCycles(argTarget > 0 ? std::max<uint64_t>(NanoPerSec / argTarget, 1) : 0)
   {}
 
   // we don't currently protect it with mutexes because this is only used for read-only printing at the moment
@@ -465,17 +655,70 @@ namespace Evaluator
     data.maxIndex = maxIndex;
     data.observations = observations;
     data.median = median.GetQuantile();
+    data.p99 = p99 ? p99->GetQuantile() : 0.0;
+    if (restored.observations > 0)
+    {
+      const uint64_t newObservations = observations - restored.observations;
+      data.median = (restored.median * restored.observations + data.median * newObservations) / observations;
+    }
     data.target = target;
     data.bucketWidth = bucketWidth;
     std::memcpy(data.buckets, buckets, sizeof(buckets));
+    data.blockCycles = blockCycles;
+    data.blocks = blocks + restored.blocks;
+    data.blockMaxSum = blockMaxSum + restored.blockMaxSum;
+    data.blockMaxSumSquares = blockMaxSumSquares + restored.blockMaxSumSquares;
+    data.pageFaultsMeasured = pageFaultsMeasured;
+    data.minorPageFaults = minorPageFaults + restored.minorPageFaults;
+    data.majorPageFaults = majorPageFaults + restored.majorPageFaults;
     return data;
   }
 
+  void TimerReport::Restore(const ReportData& data)
+  {
+    restored = data;
+    min = data.min;
+    max = data.max;
+    sum = data.sum;
+    minIndex = data.minIndex;
+    maxIndex = data.maxIndex;
+    observations = data.observations;
+    std::memcpy(buckets, data.buckets, sizeof(buckets));
+    indexOffset = static_cast<int>(data.observations);
+
+    if (uploadLocation != nullptr)
+    {
+      PublishReportData(*uploadLocation, Snapshot());
+    }
+  }
+
+  void TimerReport::TrackP99()
+  {
+    p99.emplace(0.99);
+  }
+
+  void TimerReport::SetPageFaults(uint64_t minorFaults, uint64_t majorFaults)
+  {
+    pageFaultsMeasured = true;
+    minorPageFaults = minorFaults;
+    majorPageFaults = majorFaults;
+
+    if (uploadLocation != nullptr)
+    {
+      PublishReportData(*uploadLocation, Snapshot());
+    }
+  }
+
   void TimerReport::AddObservation(uint64_t observation, int index)
   {
+    index += indexOffset;
     observations++;
     sum += observation;
     median.AddObservation(observation);
+    if (p99)
+    {
+      p99->AddObservation(observation);
+    }
 
     if (observation < min)
     {
@@ -491,10 +734,20 @@ namespace Evaluator
     int64_t difference = std::cmp_greater_equal(observation, target) ? (observation - target) : 0;
     ++buckets[GetBucketIndex(difference, bucketWidth, BucketCount)];
 
+    blockMax = std::max<uint64_t>(blockMax, difference);
+    if (blockCycles > 0 && ++blockFill == blockCycles)
+    {
+      const double maximum = static_cast<double>(blockMax);
+      ++blocks;
+      blockMaxSum += maximum;
+      blockMaxSumSquares += maximum * maximum;
+      blockFill = 0;
+      blockMax = 0;
+    }
+
     if (uploadLocation != nullptr)
     {
-      auto snapshot = Snapshot();
-      *uploadLocation = snapshot;
+      PublishReportData(*uploadLocation, Snapshot());
     }
   }
 
@@ -503,6 +756,143 @@ namespace Evaluator
   //   PrintReportCountLines(Snapshot(), isVerbose, stream);
   // }
 
+  bool RunVerdict::Passed() const
+  {
+    return Completed && Observations > 0 && GetBucketIndex(MaxLatency, BucketWidth, BucketCount) <= PassBucketIndex;
+  }
+
+  void RunVerdict::AddRow(const ReportData& data)
+  {
+    if (data.observations == 0) { return; }
+    uint64_t latency = data.max > data.target ? data.max - data.target : 0;
+    MaxLatency = std::max(MaxLatency, latency);
+    Overruns = std::max(Overruns, data.buckets[BucketCount - 1]);
+    PageFaults += data.minorPageFaults + data.majorPageFaults;
+  }
+
+  void PrintVerdictTable(std::ostream& stream, std::string_view title, const std::vector<RunVerdict>& results)
+  {
+    static constexpr int columnWidth = 10;
+    static constexpr const char* labels[] = { "Period us", "Rate Hz", "Count", "Max us", "Category", "Overruns", "Faults", "Verdict" };
+
+    int labelWidth = TableMaker::DefaultRowLabelWidth;
+    for (const auto& result : results)
+    {
+      labelWidth = std::max(labelWidth, static_cast<int>(result.Label.size()));
+    }
+
+    stream << title << "\n";
+    stream << TableMaker::BeginRow << std::setfill(' ') << std::left << std::setw(labelWidth) << "Label" << std::right << TableMaker::Separator;
+    for (const char* label : labels)
+    {
+      stream << std::setw(columnWidth) << label << TableMaker::Separator;
+    }
+    stream << "\n|" << std::string(labelWidth + 2, TableMaker::Dash) << TableMaker::DashJoint;
+    for (size_t index = 0; index < std::size(labels); ++index)
+    {
+      stream << std::string(columnWidth + 2, TableMaker::Dash) << TableMaker::DashJoint;
+    }
+    stream << "\n";
+
+    for (const auto& result : results)
+    {
+      size_t bucketIndex = GetBucketIndex(result.MaxLatency, result.BucketWidth, BucketCount);
+      const char* verdict = result.Passed() ? "PASS" : (result.Completed ? "FAIL" : "ERROR");
+      const char* verdictColor = result.Passed() ? BucketColorScheme::GetColor(0) : BucketColorScheme::GetColor(BucketCount - 1);
+      stream << TableMaker::BeginRow << std::left << std::setw(labelWidth) << result.Label << std::right << TableMaker::Separator
+             << std::setw(columnWidth) << static_cast<uint64_t>(result.Period * NanoToMicro) << TableMaker::Separator
+             << std::setw(columnWidth) << (result.Period > 0 ? NanoPerSec / result.Period : 0) << TableMaker::Separator
+             << std::setw(columnWidth) << result.Observations << TableMaker::Separator
+             << BucketColorScheme::GetColor(bucketIndex) << std::setw(columnWidth) << static_cast<uint64_t>(result.MaxLatency * NanoToMicro)
+             << BucketColorScheme::GetResetColor() << TableMaker::Separator
+             << BucketColorScheme::GetColor(bucketIndex) << std::setw(columnWidth) << BucketColorScheme::GetCategory(bucketIndex)
+             << BucketColorScheme::GetResetColor() << TableMaker::Separator
+             << std::setw(columnWidth) << result.Overruns << TableMaker::Separator
+             << std::setw(columnWidth) << result.PageFaults << TableMaker::Separator
+             << verdictColor << std::setw(columnWidth) << verdict << BucketColorScheme::GetResetColor() << TableMaker::Separator
+             << "\n";
+    }
+  }
+
+  void PrintSweepVerdict(std::ostream& stream, const std::vector<RunVerdict>& results)
+  {
+    PrintVerdictTable(stream, "Sweep verdict", results);
+
+    const RunVerdict* best = nullptr;
+    for (const auto& result : results)
+    {
+      if (result.Passed() && (best == nullptr || result.Period < best->Period))
+      {
+        best = &result;
+      }
+    }
+
+    if (best != nullptr)
+    {
+      stream << "Highest passing rate: " << NanoPerSec / best->Period << " Hz ("
+             << static_cast<uint64_t>(best->Period * NanoToMicro) << "us period)\n";
+    }
+    else
+    {
+      stream << "No swept rate passed.\n";
+    }
+  }
+
+  void PrintNicSweepTable(std::ostream& stream, const std::vector<NicSweepResult>& results)
+  {
+    static constexpr int columnWidth = 10;
+    static constexpr const char* labels[] = { "Count", "RX p99 us", "RX max us", "Category" };
+
+    int labelWidth = TableMaker::DefaultRowLabelWidth;
+    for (const auto& result : results)
+    {
+      labelWidth = std::max(labelWidth, static_cast<int>(result.Setting.size()));
+    }
+
+    stream << "NIC settings sweep\n";
+    stream << TableMaker::BeginRow << std::setfill(' ') << std::left << std::setw(labelWidth) << "Setting" << std::right << TableMaker::Separator;
+    for (const char* label : labels)
+    {
+      stream << std::setw(columnWidth) << label << TableMaker::Separator;
+    }
+    stream << "\n|" << std::string(labelWidth + 2, TableMaker::Dash) << TableMaker::DashJoint;
+    for (size_t index = 0; index < std::size(labels); ++index)
+    {
+      stream << std::string(columnWidth + 2, TableMaker::Dash) << TableMaker::DashJoint;
+    }
+    stream << "\n";
+
+    const NicSweepResult* best = nullptr;
+    for (const auto& result : results)
+    {
+      stream << TableMaker::BeginRow << std::left << std::setw(labelWidth) << result.Setting << std::right << TableMaker::Separator;
+      if (!result.Error.empty())
+      {
+        stream << BucketColorScheme::GetColor(BucketCount - 1) << "rejected: " << result.Error << BucketColorScheme::GetResetColor() << "\n";
+        continue;
+      }
+      size_t p99Index = GetBucketIndex(result.P99Latency, result.BucketWidth, BucketCount);
+      size_t maxIndex = GetBucketIndex(result.MaxLatency, result.BucketWidth, BucketCount);
+      stream << std::setw(columnWidth) << result.Observations << TableMaker::Separator
+             << BucketColorScheme::GetColor(p99Index) << std::setw(columnWidth) << static_cast<uint64_t>(result.P99Latency * NanoToMicro)
+             << BucketColorScheme::GetResetColor() << TableMaker::Separator
+             << BucketColorScheme::GetColor(maxIndex) << std::setw(columnWidth) << static_cast<uint64_t>(result.MaxLatency * NanoToMicro)
+             << BucketColorScheme::GetResetColor() << TableMaker::Separator
+             << BucketColorScheme::GetColor(maxIndex) << std::setw(columnWidth) << BucketColorScheme::GetCategory(maxIndex)
+             << BucketColorScheme::GetResetColor() << TableMaker::Separator
+             << "\n";
+      if (result.Observations > 0 && (best == nullptr || std::tie(result.P99Latency, result.MaxLatency) < std::tie(best->P99Latency, best->MaxLatency)))
+      {
+        best = &result;
+      }
+    }
+
+    if (best != nullptr)
+    {
+      stream << "Lowest receive p99: " << best->Setting << "\n";
+    }
+  }
+
   DurationReporter::DurationReporter(const std::string& msg)
     : msg_(msg)
     , start_(std::chrono::steady_clock::now())
@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+
+#include "nictest.h"
+#include "rtarena.h"
+
+namespace Evaluator
+{
+  static thread_local RtArena* threadArena = nullptr;
+
+  RtArena::RtArena(size_t argSize, int node)
+    : size(argSize)
+  {
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to allocate RT arena."));
+    }
+    base = static_cast<char*>(mapping);
+    if (node != UnboundMemoryNode)
+    {
+      try
+      {
+        BindMemoryToNode(base, size, node);
+      }
+      catch (...)
+      {
+        munmap(base, size);
+        throw;
+      }
+    }
+
+    // MAP_POPULATE is only a hint, so touch every page and lock them in case mlockall() was not called
+    std::memset(base, 0, size);
+    mlock(base, size);
+  }
+
+  RtArena::~RtArena()
+  {
+    munmap(base, size);
+  }
+
+  void* RtArena::do_allocate(size_t bytes, size_t alignment)
+  {
+    const size_t start = (used + alignment - 1) & ~(alignment - 1);
+    if (start > size || bytes > size - start)
+    {
+      throw std::bad_alloc();
+    }
+    used = start + bytes;
+    return base + start;
+  }
+
+  RtArena* RtArena::ForThisThread() noexcept
+  {
+    return threadArena;
+  }
+
+  void RtArena::SetForThisThread(RtArena* arena) noexcept
+  {
+    threadArena = arena;
+  }
+} // end namespace Evaluator
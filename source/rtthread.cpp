@@ -0,0 +1,136 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "eventlog.h"
+#include "nictest.h"
+#include "rtthread.h"
+#include "timing.h"
+
+namespace Evaluator
+{
+  RtThread::RtThread(const RtThreadAttributes& attributes, std::function<void()> argBody)
+    : body(std::move(argBody))
+    , memoryNode(ResolveMemoryNode(attributes.MemoryNode, attributes.Cpu))
+  {
+    if (attributes.ArenaSize > 0)
+    {
+      arena = std::make_unique<RtArena>(attributes.ArenaSize, memoryNode);
+    }
+
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t stackSize = ((attributes.StackSize + pageSize - 1) / pageSize) * pageSize;
+
+    // One extra page below the stack acts as a guard page since pthread_attr_setstack() does not add one
+    mappingSize = stackSize + pageSize;
+    mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK | MAP_POPULATE, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+      mapping = nullptr;
+      throw std::runtime_error(AppendErrorCode("Failed to allocate RT thread stack."));
+    }
+    if (mprotect(mapping, pageSize, PROT_NONE) != 0)
+    {
+      munmap(mapping, mappingSize);
+      throw std::runtime_error(AppendErrorCode("Failed to protect RT thread stack guard page."));
+    }
+    void* stack = static_cast<char*>(mapping) + pageSize;
+    if (memoryNode != UnboundMemoryNode)
+    {
+      try
+      {
+        BindMemoryToNode(stack, stackSize, memoryNode);
+      }
+      catch (...)
+      {
+        munmap(mapping, mappingSize);
+        throw;
+      }
+    }
+
+    // MAP_POPULATE is only a hint, so touch every page and lock them in case mlockall() was not called
+    std::memset(stack, 0, stackSize);
+    mlock(stack, stackSize);
+
+    auto fail = [this](pthread_attr_t* attr, int error, const std::string& message)
+    {
+      if (attr != nullptr) { pthread_attr_destroy(attr); }
+      munmap(mapping, mappingSize);
+      errno = error;
+      throw std::runtime_error(AppendErrorCode(message));
+    };
+
+    pthread_attr_t attr;
+    if (int error = pthread_attr_init(&attr)) { fail(nullptr, error, "Failed to initialize RT thread attributes."); }
+    if (int error = pthread_attr_setstack(&attr, stack, stackSize)) { fail(&attr, error, "Failed to set RT thread stack."); }
+    if (int error = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED)) { fail(&attr, error, "Failed to set explicit scheduling."); }
+    if (int error = pthread_attr_setschedpolicy(&attr, attributes.Policy)) { fail(&attr, error, "Failed to set RT thread policy."); }
+
+    sched_param schedParams = {};
+    schedParams.sched_priority = (attributes.Policy == SCHED_FIFO || attributes.Policy == SCHED_RR) ? attributes.Priority : 0;
+    if (int error = pthread_attr_setschedparam(&attr, &schedParams))
+    { fail(&attr, error, "Failed to set RT thread priority to " + std::to_string(attributes.Priority)); }
+
+    cpu_set_t affinityMask;
+    CPU_ZERO(&affinityMask);
+    CPU_SET(attributes.Cpu, &affinityMask);
+    if (int error = pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &affinityMask))
+    { fail(&attr, error, "Failed to set the cpu affinity to CPU_CORE: " + std::to_string(attributes.Cpu)); }
+
+    if (int error = pthread_create(&thread, &attr, &RtThread::Run, this)) { fail(&attr, error, "Failed to create RT thread."); }
+    pthread_attr_destroy(&attr);
+    joinable = true;
+  }
+
+  RtThread::~RtThread()
+  {
+    Join();
+    if (mapping != nullptr)
+    {
+      munmap(mapping, mappingSize);
+    }
+  }
+
+  void RtThread::Join()
+  {
+    if (joinable)
+    {
+      pthread_join(thread, nullptr);
+      joinable = false;
+    }
+  }
+
+  void* RtThread::Run(void* argument)
+  {
+    RtThread* self = static_cast<RtThread*>(argument);
+    RtArena::SetForThisThread(self->arena.get());
+    std::optional<ScopedMemoryNode> memoryPolicy;
+    try
+    {
+      memoryPolicy.emplace(self->memoryNode);
+    }
+    catch (const std::exception& error)
+    {
+      GetEventLog().Post(EventLevel::Error, "RtThread", error.what()); // the stack and arena are still placed
+    }
+    try
+    {
+      SetRtTimerSlack();
+    }
+    catch (const std::exception& error)
+    {
+      GetEventLog().Post(EventLevel::Error, "RtThread", error.what());
+    }
+    self->body();
+    memoryPolicy.reset();
+    RtArena::SetForThisThread(nullptr);
+    return nullptr;
+  }
+} // end namespace Evaluator
@@ -0,0 +1,165 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <cctype>
+#include <csignal>
+#include <fstream>
+#include <stdexcept>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "nictest.h"
+#include "scenario.h"
+
+namespace Evaluator
+{
+  namespace
+  {
+    std::string Trim(const std::string& str)
+    {
+      auto notspace = [](unsigned char ch) { return !std::isspace(ch); };
+      auto begin = std::find_if(str.begin(), str.end(), notspace);
+      auto end = std::find_if(str.rbegin(), str.rend(), notspace).base();
+      return begin < end ? std::string(begin, end) : std::string();
+    }
+
+    uint64_t ParseUnsigned(const std::string& value)
+    {
+      size_t parsed = 0;
+      uint64_t result = 0;
+      try { result = std::stoull(value, &parsed); } catch (...) { parsed = 0; }
+      if (parsed == 0 || parsed != value.size() || value.front() == '-')
+      {
+        throw std::invalid_argument("expected a non-negative integer, got \"" + value + "\"");
+      }
+      return result;
+    }
+
+    // "90", "90s", "5m" or "24h"
+    uint64_t ParseDurationSeconds(const std::string& value)
+    {
+      static constexpr uint64_t SecondsPerMinute = 60;
+      static constexpr uint64_t SecondsPerHour = 60 * SecondsPerMinute;
+      if (value.empty()) { throw std::invalid_argument("empty duration"); }
+      switch (value.back())
+      {
+        case 's': return ParseUnsigned(value.substr(0, value.size() - 1));
+        case 'm': return ParseUnsigned(value.substr(0, value.size() - 1)) * SecondsPerMinute;
+        case 'h': return ParseUnsigned(value.substr(0, value.size() - 1)) * SecondsPerHour;
+        default: return ParseUnsigned(value);
+      }
+    }
+
+    void ApplyKey(ScenarioPhase& phase, const std::string& key, const std::string& value)
+    {
+      if (key == "duration") { phase.DurationSeconds = ParseDurationSeconds(value); }
+      else if (key == "period") { phase.PeriodMicroseconds = ParseUnsigned(value); }
+      else if (key == "cpu") { phase.SendCpu = phase.ReceiveCpu = static_cast<int>(ParseUnsigned(value)); }
+      else if (key == "send-cpu") { phase.SendCpu = static_cast<int>(ParseUnsigned(value)); }
+      else if (key == "receive-cpu") { phase.ReceiveCpu = static_cast<int>(ParseUnsigned(value)); }
+      else if (key == "nic") { phase.NicName = value; }
+      else if (key == "load") { phase.Load = value; }
+      else if (key == "warmup") { phase.WarmupMilliseconds = ParseUnsigned(value); }
+      else if (key == "scheduler") { phase.Scheduler = value; }
+      else if (key == "timer") { phase.Timer = value; }
+      else { throw std::invalid_argument("unknown key \"" + key + "\""); }
+    }
+  } // end anonymous namespace
+
+  std::vector<ScenarioPhase> LoadScenario(const std::string& path)
+  {
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to open scenario file " + path));
+    }
+
+    ScenarioPhase defaults;
+    std::vector<ScenarioPhase> phases;
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line))
+    {
+      ++lineNumber;
+      auto fail = [&](const std::string& message)
+      {
+        throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": " + message);
+      };
+
+      line = Trim(line);
+      if (line.empty() || line.front() == '#' || line.front() == ';') { continue; }
+
+      if (line.front() == '[')
+      {
+        if (line.back() != ']') { fail("unterminated section header"); }
+        ScenarioPhase phase = defaults;
+        phase.Name = Trim(line.substr(1, line.size() - 2));
+        if (phase.Name.empty()) { fail("empty phase name"); }
+        phases.push_back(phase);
+        continue;
+      }
+
+      auto equals = line.find('=');
+      if (equals == std::string::npos) { fail("expected key = value"); }
+      std::string key = Trim(line.substr(0, equals));
+      std::string value = Trim(line.substr(equals + 1));
+      if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+      {
+        value = value.substr(1, value.size() - 2);
+      }
+
+      try
+      {
+        ApplyKey(phases.empty() ? defaults : phases.back(), key, value);
+      }
+      catch (const std::invalid_argument& error)
+      {
+        fail(error.what());
+      }
+    }
+
+    if (phases.empty())
+    {
+      throw std::runtime_error(path + ": no [phase] sections");
+    }
+    for (const auto& phase : phases)
+    {
+      if (phase.DurationSeconds == 0)
+      {
+        throw std::runtime_error(path + ": phase \"" + phase.Name + "\" has no duration");
+      }
+    }
+    return phases;
+  }
+
+  BackgroundLoad::BackgroundLoad(const std::string& command)
+  {
+    pid = fork();
+    if (pid == -1)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to start load \"" + command + "\""));
+    }
+    if (pid == 0)
+    {
+      // Own process group so that everything the shell starts can be stopped together.
+      // The signal mask survives exec, so undo the shutdown signals blocked for signalfd.
+      setpgid(0, 0);
+      sigset_t signals;
+      sigemptyset(&signals);
+      sigprocmask(SIG_SETMASK, &signals, nullptr);
+      execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+      _exit(127);
+    }
+    setpgid(pid, pid);
+  }
+
+  BackgroundLoad::~BackgroundLoad()
+  {
+    if (pid > 0)
+    {
+      kill(-pid, SIGTERM);
+      waitpid(pid, nullptr, 0);
+    }
+  }
+} // end namespace Evaluator
@@ -0,0 +1,245 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "nictest.h"
+#include "rtthread.h"
+#include "signalbench.h"
+
+namespace Evaluator
+{
+  static constexpr uint64_t SignalWarmupWakeups = 100;
+
+  const char* GetSignalMechanismName(SignalMechanism mechanism)
+  {
+    switch (mechanism)
+    {
+      case SignalMechanism::Futex: return "futex";
+      case SignalMechanism::Eventfd: return "eventfd";
+      case SignalMechanism::Pipe: return "pipe";
+    }
+    return "unknown";
+  }
+
+  std::optional<SignalMechanism> ParseSignalMechanism(std::string_view name)
+  {
+    for (SignalMechanism mechanism : AllSignalMechanisms)
+    {
+      if (name == GetSignalMechanismName(mechanism)) { return mechanism; }
+    }
+    return std::nullopt;
+  }
+
+  class FutexSignal final : public ISignal
+  {
+    std::atomic<uint32_t> counter = 0;
+    uint32_t seen = 0; // last counter value the waiter consumed, only touched by the waiter
+  public:
+    void Signal() override
+    {
+      counter.fetch_add(1, std::memory_order_release);
+      if (syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0) == -1)
+      { throw std::runtime_error(AppendErrorCode("Failed to wake the futex.")); }
+    }
+
+    void Wait() override
+    {
+      uint32_t current = counter.load(std::memory_order_acquire);
+      while (current == seen)
+      {
+        // EAGAIN means the counter moved before the kernel checked it, EINTR a signal; both just retry
+        if (syscall(SYS_futex, reinterpret_cast<uint32_t*>(&counter), FUTEX_WAIT_PRIVATE, seen, nullptr, nullptr, 0) == -1
+            && errno != EAGAIN && errno != EINTR)
+        { throw std::runtime_error(AppendErrorCode("Failed to wait on the futex.")); }
+        current = counter.load(std::memory_order_acquire);
+      }
+      seen = current;
+    }
+  };
+
+  class EventfdSignal final : public ISignal
+  {
+    int eventDescriptor = -1;
+  public:
+    EventfdSignal()
+    {
+      eventDescriptor = eventfd(0, EFD_CLOEXEC);
+      if (eventDescriptor == -1)
+      { throw std::runtime_error(AppendErrorCode("Failed to create eventfd.")); }
+    }
+
+    ~EventfdSignal() override
+    {
+      close(eventDescriptor);
+    }
+
+    void Signal() override
+    {
+      const uint64_t value = 1;
+      if (write(eventDescriptor, &value, sizeof(value)) != sizeof(value))
+      { throw std::runtime_error(AppendErrorCode("Failed to write to the eventfd.")); }
+    }
+
+    void Wait() override
+    {
+      uint64_t value = 0;
+      while (read(eventDescriptor, &value, sizeof(value)) != sizeof(value))
+      {
+        if (errno != EINTR) { throw std::runtime_error(AppendErrorCode("Failed to read from the eventfd.")); }
+      }
+    }
+  };
+
+  class PipeSignal final : public ISignal
+  {
+    int descriptors[2] = { -1, -1 };
+  public:
+    PipeSignal()
+    {
+      if (pipe2(descriptors, O_CLOEXEC) == -1)
+      { throw std::runtime_error(AppendErrorCode("Failed to create pipe.")); }
+    }
+
+    ~PipeSignal() override
+    {
+      close(descriptors[0]);
+      close(descriptors[1]);
+    }
+
+    void Signal() override
+    {
+      const char byte = 0;
+      if (write(descriptors[1], &byte, 1) != 1)
+      { throw std::runtime_error(AppendErrorCode("Failed to write to the pipe.")); }
+    }
+
+    void Wait() override
+    {
+      char byte = 0;
+      while (read(descriptors[0], &byte, 1) != 1)
+      {
+        if (errno != EINTR) { throw std::runtime_error(AppendErrorCode("Failed to read from the pipe.")); }
+      }
+    }
+  };
+
+  std::unique_ptr<ISignal> CreateSignal(SignalMechanism mechanism)
+  {
+    switch (mechanism)
+    {
+      case SignalMechanism::Futex: return std::make_unique<FutexSignal>();
+      case SignalMechanism::Eventfd: return std::make_unique<EventfdSignal>();
+      case SignalMechanism::Pipe: return std::make_unique<PipeSignal>();
+    }
+    throw std::runtime_error("Unknown signal mechanism.");
+  }
+
+  SignalBenchResult MeasureSignalLatency(SignalMechanism mechanism, int fromCpu, int fromPriority,
+    int toCpu, int toPriority, uint64_t intervalNanoseconds, uint64_t wakeups)
+  {
+    SignalBenchResult result;
+    result.Mechanism = mechanism;
+    result.FromCpu = fromCpu;
+    result.ToCpu = toCpu;
+
+    std::atomic<uint64_t> sentAt = 0;
+    std::atomic<uint64_t> acknowledged = 0; // signals the waiter has timed
+    std::atomic_bool done = false;
+    std::atomic_bool waiterFailed = false;
+    std::string waiterError;
+    std::string signallerError;
+    try
+    {
+      std::unique_ptr<ISignal> signal = CreateSignal(mechanism);
+
+      RtThreadAttributes attributes;
+      attributes.Cpu = toCpu;
+      attributes.Priority = toPriority;
+      RtThread waiter(attributes, [&]
+      {
+        try
+        {
+          for (uint64_t index = 0; ; ++index)
+          {
+            signal->Wait();
+            const uint64_t now = GetCurrentTime();
+            if (done.load(std::memory_order_acquire)) { return; }
+            const uint64_t sent = sentAt.load(std::memory_order_acquire);
+            if (index >= SignalWarmupWakeups)
+            {
+              result.Latency.AddObservation(now > sent ? now - sent : 0, static_cast<int>(index - SignalWarmupWakeups));
+            }
+            acknowledged.store(index + 1, std::memory_order_release);
+          }
+        }
+        catch (const std::exception& error)
+        {
+          waiterError = error.what();
+          waiterFailed.store(true, std::memory_order_relaxed);
+        }
+      });
+
+      // The waiter blocks until told to stop, so make sure it is told even if the signaller fails
+      auto stopWaiter = [&]
+      {
+        done.store(true, std::memory_order_release);
+        try { signal->Signal(); } catch (const std::exception&) {}
+        waiter.Join();
+      };
+
+      try
+      {
+        attributes.Cpu = fromCpu;
+        attributes.Priority = fromPriority;
+        RtThread signaller(attributes, [&]
+        {
+          try
+          {
+            const uint64_t start = GetCurrentTime();
+            uint64_t sent = 0;
+            for (uint64_t tick = 0; sent < SignalWarmupWakeups + wakeups && !waiterFailed.load(std::memory_order_relaxed); ++tick)
+            {
+              const uint64_t wakeAt = start + (tick + 1) * intervalNanoseconds;
+              const timespec next = { static_cast<time_t>(wakeAt / NanoPerSec), static_cast<long>(wakeAt % NanoPerSec) };
+              while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr) == EINTR) {}
+              // Each wake is timed against its own signal: while the waiter hasn't run since the last one,
+              // sentAt must not move, so the ticks it is late for are skipped
+              if (acknowledged.load(std::memory_order_acquire) != sent) { continue; }
+              sentAt.store(GetCurrentTime(), std::memory_order_release);
+              signal->Signal();
+              ++sent;
+            }
+          }
+          catch (const std::exception& error)
+          {
+            signallerError = error.what();
+          }
+        });
+        signaller.Join();
+      }
+      catch (...)
+      {
+        stopWaiter();
+        throw;
+      }
+      stopWaiter();
+    }
+    catch (const std::exception& error)
+    {
+      result.Error = error.what();
+      return result;
+    }
+
+    result.Error = !signallerError.empty() ? signallerError : waiterError;
+    return result;
+  }
+} // end namespace Evaluator
@@ -0,0 +1,155 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <numbers>
+#include <sstream>
+
+#include "tailestimate.h"
+
+namespace Evaluator
+{
+  static constexpr double EulerGamma = 0.5772156649015329;
+  static constexpr double GumbelScaleFactor = std::numbers::sqrt2 * std::numbers::sqrt3 / std::numbers::pi; // sqrt(6) / pi
+  static constexpr double ConfidenceZ = 1.96; // two-sided 95%
+
+  // Search range of the reduced variate y = -ln(-ln F); beyond 60 the exceedance probability is below 1e-26
+  static constexpr double MinimumReducedVariate = -3;
+  static constexpr double MaximumReducedVariate = 60;
+  static constexpr int BisectionSteps = 100;
+
+  static constexpr double SecondsPerMinute = 60;
+  static constexpr double SecondsPerHour = 60 * SecondsPerMinute;
+  static constexpr double SecondsPerDay = 24 * SecondsPerHour;
+  static constexpr double SecondsPerYear = 365.25 * SecondsPerDay;
+  static constexpr double LongestDescribedYears = 1000;
+
+  std::optional<GumbelFit> FitGumbel(const ReportData& data)
+  {
+    if (data.blockCycles == 0 || data.blocks < MinimumTailBlocks)
+    {
+      return std::nullopt;
+    }
+
+    GumbelFit fit;
+    const double blocks = static_cast<double>(data.blocks);
+    fit.Blocks = data.blocks;
+    fit.BlockSeconds = static_cast<double>(data.blockCycles * data.target) / NanoPerSec;
+    fit.Mean = data.blockMaxSum / blocks;
+    const double variance = (data.blockMaxSumSquares - blocks * fit.Mean * fit.Mean) / (blocks - 1);
+    fit.StdDev = variance > 0 ? std::sqrt(variance) : 0;
+    fit.Scale = GumbelScaleFactor * fit.StdDev;
+    fit.Location = fit.Mean - EulerGamma * fit.Scale;
+    return fit;
+  }
+
+  // Block maximum at reduced variate `y`, moved by `z` standard errors. The standard error of a
+  // method-of-moments Gumbel quantile with frequency factor K is s / sqrt(n) * sqrt(1 + 1.1396 K + 1.1 K^2).
+  static double GumbelQuantile(const GumbelFit& fit, double y, double z)
+  {
+    const double k = GumbelScaleFactor * (y - EulerGamma);
+    const double standardError = fit.StdDev / std::sqrt(static_cast<double>(fit.Blocks)) * std::sqrt(1 + 1.1396 * k + 1.1 * k * k);
+    return fit.Mean + k * fit.StdDev + z * standardError;
+  }
+
+  // Reduced variate at which GumbelQuantile() reaches `threshold`; the quantile rises with y for n >= 10
+  static double SolveReducedVariate(const GumbelFit& fit, double threshold, double z)
+  {
+    double low = MinimumReducedVariate;
+    double high = MaximumReducedVariate;
+    if (GumbelQuantile(fit, low, z) >= threshold) { return low; }
+    if (GumbelQuantile(fit, high, z) < threshold) { return high; }
+    for (int step = 0; step < BisectionSteps; ++step)
+    {
+      const double middle = (low + high) / 2;
+      (GumbelQuantile(fit, middle, z) < threshold ? low : high) = middle;
+    }
+    return (low + high) / 2;
+  }
+
+  // P(block maximum > quantile at y) = 1 - exp(-exp(-y))
+  static double GetExceedanceProbability(double y)
+  {
+    return -std::expm1(-std::exp(-y));
+  }
+
+  ExceedanceEstimate EstimateExceedance(const GumbelFit& fit, uint64_t threshold)
+  {
+    ExceedanceEstimate estimate;
+    estimate.Threshold = threshold;
+    const double limit = static_cast<double>(threshold);
+    if (fit.StdDev == 0)
+    {
+      // Every block had the same maximum, so there is nothing to extrapolate from
+      estimate.Probability = (limit <= fit.Mean) ? 1 : 0;
+      estimate.ProbabilityLow = estimate.Probability;
+      estimate.ProbabilityHigh = estimate.Probability;
+    }
+    else
+    {
+      estimate.Probability = GetExceedanceProbability(SolveReducedVariate(fit, limit, 0));
+      // A higher quantile curve reaches the threshold at a lower y, i.e. more often
+      estimate.ProbabilityHigh = GetExceedanceProbability(SolveReducedVariate(fit, limit, ConfidenceZ));
+      estimate.ProbabilityLow = GetExceedanceProbability(SolveReducedVariate(fit, limit, -ConfidenceZ));
+    }
+
+    auto between = [&fit](double probability)
+    {
+      return probability > 0 ? fit.BlockSeconds / probability : std::numeric_limits<double>::infinity();
+    };
+    estimate.SecondsBetween = between(estimate.Probability);
+    estimate.SecondsBetweenLow = between(estimate.ProbabilityHigh);
+    estimate.SecondsBetweenHigh = between(estimate.ProbabilityLow);
+    return estimate;
+  }
+
+  std::string DescribeInterval(double seconds)
+  {
+    std::ostringstream output;
+    auto print = [&output](double value, const char* unit)
+    {
+      output << std::fixed << std::setprecision(value < 10 ? 1 : 0) << value << " " << unit;
+    };
+
+    if (seconds < 2 * SecondsPerMinute) { print(seconds, "s"); }
+    else if (seconds < 2 * SecondsPerHour) { print(seconds / SecondsPerMinute, "min"); }
+    else if (seconds < 2 * SecondsPerDay) { print(seconds / SecondsPerHour, "h"); }
+    else if (seconds < 2 * SecondsPerYear) { print(seconds / SecondsPerDay, "days"); }
+    else if (seconds < LongestDescribedYears * SecondsPerYear) { print(seconds / SecondsPerYear, "years"); }
+    else { output << "> " << LongestDescribedYears << " years"; }
+    return output.str();
+  }
+
+  void PrintTailEstimate(std::ostream& stream, std::string_view label, const ReportData& data)
+  {
+    if (data.observations == 0 || data.blockCycles == 0)
+    {
+      return;
+    }
+
+    auto fit = FitGumbel(data);
+    const double blockSeconds = static_cast<double>(data.blockCycles * data.target) / NanoPerSec;
+    if (!fit)
+    {
+      stream << label << " tail estimate: needs " << MinimumTailBlocks << " blocks of " << DescribeInterval(blockSeconds)
+             << ", have " << data.blocks << ".\n";
+      return;
+    }
+
+    stream << label << " tail estimate from a Gumbel fit of the maxima of " << fit->Blocks << " blocks of "
+           << DescribeInterval(fit->BlockSeconds) << ", 95% confidence:\n" << std::setfill(' ');
+    for (size_t bucketIndex = 1; bucketIndex < BucketCount; ++bucketIndex)
+    {
+      const uint64_t threshold = data.bucketWidth << (bucketIndex - 1);
+      const ExceedanceEstimate estimate = EstimateExceedance(*fit, threshold);
+      stream << "  " << BucketColorScheme::GetColor(bucketIndex) << std::setw(9) << BucketColorScheme::GetCategory(bucketIndex)
+             << BucketColorScheme::GetResetColor() << " (>= " << std::setw(5) << static_cast<uint64_t>(threshold * NanoToMicro) << "us): "
+             << std::scientific << std::setprecision(1) << estimate.Probability
+             << " [" << estimate.ProbabilityLow << ", " << estimate.ProbabilityHigh << "] per block" << std::defaultfloat
+             << ", once every " << DescribeInterval(estimate.SecondsBetween)
+             << " [" << DescribeInterval(estimate.SecondsBetweenLow) << ", " << DescribeInterval(estimate.SecondsBetweenHigh) << "]\n";
+    }
+  }
+} // end namespace Evaluator
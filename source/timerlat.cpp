@@ -0,0 +1,199 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ftracesnapshot.h"
+#include "nictest.h"
+#include "timerlat.h"
+
+namespace Evaluator
+{
+  // The kernel rejects shorter timerlat periods
+  static constexpr uint64_t MinimumTimerlatPeriodMicros = 100;
+  static constexpr int ReadPollTimeoutMs = 100;
+  static constexpr size_t ReadChunkSize = 1 << 16;
+
+  static void SkipSpaces(std::string_view& text)
+  {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) { text.remove_prefix(1); }
+  }
+
+  // Consume `token` and the spaces before it, or return false
+  static bool SkipToken(std::string_view& text, std::string_view token)
+  {
+    SkipSpaces(text);
+    if (text.substr(0, token.size()) != token) { return false; }
+    text.remove_prefix(token.size());
+    return true;
+  }
+
+  static bool ParseNumber(std::string_view& text, uint64_t& value)
+  {
+    SkipSpaces(text);
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc()) { return false; }
+    text.remove_prefix(end - text.data());
+    return true;
+  }
+
+  // The sample follows the task, CPU, flags and timestamp columns:
+  //   #<sequence> context <irq|thread> timer_latency <value> <ns|us>
+  std::optional<TimerlatSample> ParseTimerlatLine(std::string_view line)
+  {
+    const size_t context = line.find(" context ");
+    const size_t hash = line.rfind('#', context);
+    if (context == std::string_view::npos || hash == std::string_view::npos)
+    {
+      return std::nullopt;
+    }
+
+    TimerlatSample sample;
+    std::string_view text = line.substr(hash + 1);
+    if (!ParseNumber(text, sample.Sequence) || !SkipToken(text, "context")) { return std::nullopt; }
+    if (SkipToken(text, "irq ")) { sample.Context = TimerlatContext::Irq; }
+    else if (SkipToken(text, "thread ")) { sample.Context = TimerlatContext::Thread; }
+    else { return std::nullopt; }
+    if (!SkipToken(text, "timer_latency") || !ParseNumber(text, sample.Nanoseconds)) { return std::nullopt; }
+    if (SkipToken(text, "us")) { sample.Nanoseconds *= NanoPerSec / 1'000'000; }
+    else if (!SkipToken(text, "ns")) { return std::nullopt; }
+    return sample;
+  }
+
+  static std::string ReadTracefs(const std::string& path)
+  {
+    std::ifstream file(path);
+    std::string value;
+    if (!file.is_open() || !std::getline(file, value))
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to read " + path));
+    }
+    return value;
+  }
+
+  TimerlatTracer::TimerlatTracer(int cpu, uint64_t period, uint64_t bucketWidth, uint64_t warmupSamples,
+    ReportData* irqData, ReportData* threadData)
+    : warmupSamples(warmupSamples)
+    , irqReport(bucketWidth, irqData, true)
+    , threadReport(bucketWidth, threadData, true)
+  {
+    const std::string root = FindTracefs();
+    osnoise = root + "/osnoise";
+    if (ReadTracefs(root + "/available_tracers").find("timerlat") == std::string::npos)
+    {
+      throw std::runtime_error("This kernel has no timerlat tracer (CONFIG_TIMERLAT_TRACER).");
+    }
+
+    instance = root + "/instances/rmp-eval-timerlat-" + std::to_string(getpid());
+    if (mkdir(instance.c_str(), 0750) != 0)
+    {
+      instance.clear();
+      throw std::runtime_error(AppendErrorCode("Failed to create tracefs instance " + root + "/instances"));
+    }
+
+    try
+    {
+      if (ReadTracefs(instance + "/available_tracers").find("timerlat") == std::string::npos)
+      {
+        throw std::runtime_error("This kernel can't run timerlat in a tracefs instance; it needs Linux 6.3 or later.");
+      }
+      originalCpus = ReadTracefs(osnoise + "/cpus");
+      originalPeriod = ReadTracefs(osnoise + "/timerlat_period_us");
+      WriteTracefs(osnoise + "/cpus", std::to_string(cpu));
+      WriteTracefs(osnoise + "/timerlat_period_us", std::to_string(std::max(period / 1000, MinimumTimerlatPeriodMicros)));
+      WriteTracefs(instance + "/current_tracer", "timerlat");
+
+      pipeFd = open((instance + "/trace_pipe").c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+      if (pipeFd < 0)
+      {
+        throw std::runtime_error(AppendErrorCode("Failed to open " + instance + "/trace_pipe"));
+      }
+      reader = std::jthread([this](std::stop_token stopToken) { Read(stopToken); });
+    }
+    catch (...)
+    {
+      Remove();
+      throw;
+    }
+  }
+
+  TimerlatTracer::~TimerlatTracer()
+  {
+    if (reader.joinable())
+    {
+      reader.request_stop();
+      reader.join();
+    }
+    Remove();
+  }
+
+  void TimerlatTracer::Remove() noexcept
+  {
+    if (pipeFd >= 0) { close(pipeFd); pipeFd = -1; }
+    if (instance.empty()) { return; }
+
+    auto restore = [](const std::string& path, const std::string& value)
+    {
+      if (value.empty()) { return; }
+      try { WriteTracefs(path, value); }
+      catch (const std::exception& error) { std::fprintf(stderr, "WARN: %s\n", error.what()); }
+    };
+    restore(instance + "/current_tracer", "nop");
+    if (rmdir(instance.c_str()) != 0)
+    {
+      std::perror(("WARN: remove tracefs instance " + instance).c_str());
+    }
+    restore(osnoise + "/cpus", originalCpus);
+    restore(osnoise + "/timerlat_period_us", originalPeriod);
+    instance.clear();
+  }
+
+  void TimerlatTracer::Read(std::stop_token stopToken)
+  {
+    std::string pending;
+    std::string chunk(ReadChunkSize, '\0');
+    auto consume = [this, &pending]
+    {
+      size_t start = 0;
+      for (size_t end = pending.find('\n'); end != std::string::npos; end = pending.find('\n', start))
+      {
+        if (auto sample = ParseTimerlatLine(std::string_view(pending).substr(start, end - start)))
+        {
+          const bool irq = sample->Context == TimerlatContext::Irq;
+          if (++(irq ? irqSamples : threadSamples) > warmupSamples)
+          {
+            (irq ? irqReport : threadReport).AddObservation(sample->Nanoseconds, static_cast<int>(sample->Sequence));
+          }
+        }
+        start = end + 1;
+      }
+      pending.erase(0, start);
+    };
+
+    // Keep reading after the stop request until the pipe is drained
+    bool stopping = false;
+    while (true)
+    {
+      pollfd pollFd = { .fd = pipeFd, .events = POLLIN, .revents = 0 };
+      const bool ready = poll(&pollFd, 1, stopping ? 0 : ReadPollTimeoutMs) > 0;
+      const ssize_t count = ready ? read(pipeFd, chunk.data(), chunk.size()) : 0;
+      if (count > 0)
+      {
+        pending.append(chunk.data(), count);
+        consume();
+        continue;
+      }
+      if (stopping) { break; }
+      stopping = stopToken.stop_requested();
+    }
+  }
+} // end namespace Evaluator
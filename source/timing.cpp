@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <algorithm>
+#include <iomanip>
+#include <sched.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/prctl.h>
+
+#include "nictest.h"
+#include "timing.h"
+
+namespace Evaluator
+{
+  // Enough reads to average out the loop, few enough to finish in well under a millisecond per clock
+  static constexpr int ClockReadsPerBatch = 1000;
+  static constexpr int ClockReadBatches = 20;
+
+  static constexpr std::pair<clockid_t, const char*> AuditedClocks[] =
+  {
+    { CLOCK_MONOTONIC, "MONOTONIC" },
+    { CLOCK_MONOTONIC_RAW, "MONOTONIC_RAW" },
+    { CLOCK_REALTIME, "REALTIME" },
+    { CLOCK_BOOTTIME, "BOOTTIME" },
+    { CLOCK_TAI, "TAI" },
+  };
+
+  void SetRtTimerSlack()
+  {
+    if (prctl(PR_SET_TIMERSLACK, RtTimerSlackNanoseconds) != 0)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to set the timer slack to " + std::to_string(RtTimerSlackNanoseconds) + " ns."));
+    }
+  }
+
+  unsigned long GetTimerSlack()
+  {
+    return static_cast<unsigned long>(prctl(PR_GET_TIMERSLACK));
+  }
+
+  // Cheapest batch, so that an interrupt during one batch doesn't count against the clock
+  static double MeasureClockReadCost(clockid_t clock)
+  {
+    double best = 0;
+    for (int batch = 0; batch < ClockReadBatches; ++batch)
+    {
+      timespec start = {};
+      timespec end = {};
+      timespec value = {};
+      clock_gettime(CLOCK_MONOTONIC, &start);
+      for (int read = 0; read < ClockReadsPerBatch; ++read)
+      {
+        clock_gettime(clock, &value);
+        asm volatile("" : : "r"(&value) : "memory");
+      }
+      clock_gettime(CLOCK_MONOTONIC, &end);
+      const double perRead = static_cast<double>(ToEpoch(end) - ToEpoch(start)) / ClockReadsPerBatch;
+      best = (batch == 0) ? perRead : std::min(best, perRead);
+    }
+    return best;
+  }
+
+  std::vector<ClockReadCost> MeasureClockReadCosts(std::optional<int> cpu)
+  {
+    cpu_set_t original;
+    CPU_ZERO(&original);
+    bool moved = false;
+    if (cpu && sched_getaffinity(0, sizeof(original), &original) == 0)
+    {
+      cpu_set_t target;
+      CPU_ZERO(&target);
+      CPU_SET(*cpu, &target);
+      moved = (sched_setaffinity(0, sizeof(target), &target) == 0);
+    }
+
+    std::vector<ClockReadCost> costs;
+    for (const auto& [clock, name] : AuditedClocks)
+    {
+      ClockReadCost cost;
+      cost.Clock = clock;
+      cost.Name = name;
+      timespec resolution = {};
+      if (clock_getres(clock, &resolution) == 0)
+      {
+        cost.Resolution = ToEpoch(resolution);
+        cost.Nanoseconds = MeasureClockReadCost(clock);
+      }
+      costs.push_back(cost);
+    }
+
+    if (moved)
+    {
+      sched_setaffinity(0, sizeof(original), &original);
+    }
+    return costs;
+  }
+
+  std::string DescribeClockReadCosts(const std::vector<ClockReadCost>& costs)
+  {
+    std::ostringstream output;
+    output << std::fixed << std::setprecision(0);
+    for (const ClockReadCost& cost : costs)
+    {
+      if (cost.Resolution == 0) { continue; }
+      output << (output.tellp() > 0 ? ", " : "") << cost.Name << " " << cost.Nanoseconds << "ns";
+    }
+    return output.str();
+  }
+
+  std::optional<std::string> ParseKernelConfigOption(std::string_view config, std::string_view option)
+  {
+    const std::string key = "CONFIG_" + std::string(option) + "=";
+    for (size_t position = config.find(key); position != std::string_view::npos; position = config.find(key, position + 1))
+    {
+      if (position != 0 && config[position - 1] != '\n') { continue; } // settings start a line
+      const size_t start = position + key.size();
+      const size_t end = config.find('\n', start);
+      return std::string(config.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+    }
+    return std::nullopt;
+  }
+} // end namespace Evaluator
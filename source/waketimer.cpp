@@ -0,0 +1,170 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <pthread.h>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "nictest.h"
+#include "waketimer.h"
+
+namespace Evaluator
+{
+  const char* GetWakeMechanismName(WakeMechanism mechanism)
+  {
+    switch (mechanism)
+    {
+      case WakeMechanism::Nanosleep: return "nanosleep";
+      case WakeMechanism::Timerfd: return "timerfd";
+      case WakeMechanism::PosixTimer: return "posix";
+      case WakeMechanism::Spin: return "spin";
+    }
+    return "unknown";
+  }
+
+  std::optional<WakeMechanism> ParseWakeMechanism(std::string_view name)
+  {
+    for (WakeMechanism mechanism : AllWakeMechanisms)
+    {
+      if (name == GetWakeMechanismName(mechanism)) { return mechanism; }
+    }
+    return std::nullopt;
+  }
+
+  class NanosleepWakeTimer final : public IWakeTimer
+  {
+  public:
+    void WaitUntil(const timespec& next) override
+    {
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, nullptr) == EINTR) {}
+    }
+  };
+
+  class TimerfdWakeTimer final : public IWakeTimer
+  {
+    int timerDescriptor = -1;
+    int epollDescriptor = -1;
+  public:
+    TimerfdWakeTimer()
+    {
+      timerDescriptor = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+      if (timerDescriptor == -1)
+      { throw std::runtime_error(AppendErrorCode("Failed to create timerfd.")); }
+
+      epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+      if (epollDescriptor == -1)
+      {
+        close(timerDescriptor);
+        throw std::runtime_error(AppendErrorCode("Failed to create epoll instance."));
+      }
+
+      epoll_event event = {};
+      event.events = EPOLLIN;
+      event.data.fd = timerDescriptor;
+      if (epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, timerDescriptor, &event) == -1)
+      {
+        close(epollDescriptor);
+        close(timerDescriptor);
+        throw std::runtime_error(AppendErrorCode("Failed to add timerfd to epoll."));
+      }
+    }
+
+    ~TimerfdWakeTimer() override
+    {
+      close(epollDescriptor);
+      close(timerDescriptor);
+    }
+
+    void WaitUntil(const timespec& next) override
+    {
+      itimerspec expiry = {};
+      expiry.it_value = next;
+      if (timerfd_settime(timerDescriptor, TFD_TIMER_ABSTIME, &expiry, nullptr) == -1)
+      { throw std::runtime_error(AppendErrorCode("Failed to arm timerfd.")); }
+
+      epoll_event event = {};
+      int ready = 0;
+      do
+      {
+        ready = epoll_wait(epollDescriptor, &event, 1, -1);
+      } while (ready == -1 && errno == EINTR);
+      if (ready == -1)
+      { throw std::runtime_error(AppendErrorCode("Failed to wait on timerfd.")); }
+
+      uint64_t expirations = 0;
+      if (read(timerDescriptor, &expirations, sizeof(expirations)) == -1 && errno != EAGAIN)
+      { throw std::runtime_error(AppendErrorCode("Failed to read timerfd.")); }
+    }
+  };
+
+  class PosixTimerWakeTimer final : public IWakeTimer
+  {
+    timer_t timer = {};
+    sigset_t signals = {};
+    const int signalNumber = SIGRTMIN;
+  public:
+    PosixTimerWakeTimer()
+    {
+      // Block the signal so that it is only consumed by sigwaitinfo()
+      sigemptyset(&signals);
+      sigaddset(&signals, signalNumber);
+      if (pthread_sigmask(SIG_BLOCK, &signals, nullptr) != 0)
+      { throw std::runtime_error(AppendErrorCode("Failed to block the timer signal.")); }
+
+      // Deliver the expiry to this thread only
+      sigevent event = {};
+      event.sigev_notify = SIGEV_THREAD_ID;
+      event.sigev_signo = signalNumber;
+      event._sigev_un._tid = gettid();
+      if (timer_create(CLOCK_MONOTONIC, &event, &timer) == -1)
+      { throw std::runtime_error(AppendErrorCode("Failed to create POSIX timer.")); }
+    }
+
+    ~PosixTimerWakeTimer() override
+    {
+      timer_delete(timer);
+    }
+
+    void WaitUntil(const timespec& next) override
+    {
+      itimerspec expiry = {};
+      expiry.it_value = next;
+      if (timer_settime(timer, TIMER_ABSTIME, &expiry, nullptr) == -1)
+      { throw std::runtime_error(AppendErrorCode("Failed to arm POSIX timer.")); }
+
+      siginfo_t info;
+      while (sigwaitinfo(&signals, &info) == -1)
+      {
+        if (errno != EINTR)
+        { throw std::runtime_error(AppendErrorCode("Failed to wait for the timer signal.")); }
+      }
+    }
+  };
+
+  class SpinWakeTimer final : public IWakeTimer
+  {
+  public:
+    void WaitUntil(const timespec& next) override
+    {
+      const uint64_t deadline = ToEpoch(next);
+      while (GetCurrentTime() < deadline) {}
+    }
+  };
+
+  std::unique_ptr<IWakeTimer> CreateWakeTimer(WakeMechanism mechanism)
+  {
+    switch (mechanism)
+    {
+      case WakeMechanism::Nanosleep: return std::make_unique<NanosleepWakeTimer>();
+      case WakeMechanism::Timerfd: return std::make_unique<TimerfdWakeTimer>();
+      case WakeMechanism::PosixTimer: return std::make_unique<PosixTimerWakeTimer>();
+      case WakeMechanism::Spin: return std::make_unique<SpinWakeTimer>();
+    }
+    throw std::runtime_error("Unknown wake mechanism.");
+  }
+} // end namespace Evaluator
@@ -0,0 +1,175 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+#include <cerrno>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#include "eventlog.h"
+#include "workerprocess.h"
+
+namespace Evaluator
+{
+  // How often the parent and the child's monitor check for a stop request or exit
+  static constexpr auto PollInterval = std::chrono::milliseconds(10);
+
+  const char* GetWorkerIsolationName(WorkerIsolation isolation)
+  {
+    switch (isolation)
+    {
+      case WorkerIsolation::Thread: return "thread";
+      case WorkerIsolation::Process: return "process";
+    }
+    return "unknown";
+  }
+
+  std::optional<WorkerIsolation> ParseWorkerIsolation(std::string_view name)
+  {
+    for (WorkerIsolation isolation : { WorkerIsolation::Thread, WorkerIsolation::Process })
+    {
+      if (name == GetWorkerIsolationName(isolation)) { return isolation; }
+    }
+    return std::nullopt;
+  }
+
+  WorkerProcess::WorkerProcess(const TestParameters& params, const WorkerFunction& work, std::atomic_bool& running)
+    : workerParams(params)
+  {
+    void* mapping = mmap(nullptr, sizeof(SharedStatistics), PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+      throw std::runtime_error(AppendErrorCode("Failed to allocate shared memory for the RT worker process."));
+    }
+    shared = new (mapping) SharedStatistics();
+
+    workerParams.SendData = &shared->Send;
+    workerParams.ReceiveData = &shared->Receive;
+    workerParams.SendOverhead = &shared->SendOverhead;
+    workerParams.ReceiveOverhead = &shared->ReceiveOverhead;
+    workerParams.Handoff = &shared->Handoff;
+    for (size_t phase = 0; phase < CyclePhaseCount; ++phase)
+    {
+      if (workerParams.Phases[phase] != nullptr) { workerParams.Phases[phase] = &shared->Phases[phase]; }
+    }
+
+    pid = fork();
+    if (pid < 0)
+    {
+      munmap(shared, sizeof(SharedStatistics));
+      throw std::runtime_error(AppendErrorCode("Failed to fork the RT worker process."));
+    }
+    if (pid == 0)
+    {
+      RunChild(work, running);
+    }
+  }
+
+  WorkerProcess::~WorkerProcess()
+  {
+    if (pid > 0)
+    {
+      // Only still running if Wait() was never reached, e.g. because the parent threw
+      shared->StopRequested.store(true, std::memory_order_release);
+      waitpid(pid, nullptr, 0);
+    }
+    munmap(shared, sizeof(SharedStatistics));
+  }
+
+  void WorkerProcess::RunChild(const WorkerFunction& work, std::atomic_bool& running)
+  {
+    int status = 0;
+    try
+    {
+      // Memory locks are not inherited across fork()
+      if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+      {
+        throw std::runtime_error(AppendErrorCode("Failed to lock memory in the RT worker process."));
+      }
+
+      std::atomic_bool workDone = false;
+      std::thread monitor([this, &running, &workDone]
+      {
+        while (!workDone.load(std::memory_order_acquire))
+        {
+          if (shared->StopRequested.load(std::memory_order_acquire))
+          {
+            running.store(false, std::memory_order_release);
+          }
+          std::this_thread::sleep_for(PollInterval);
+        }
+      });
+
+      try
+      {
+        work(workerParams, shared->Hardware, shared->Software);
+      }
+      catch (const std::exception& error)
+      {
+        GetEventLog().Post(EventLevel::Error, "Worker", error.what());
+        status = 1;
+      }
+      workDone.store(true, std::memory_order_release);
+      monitor.join();
+    }
+    catch (const std::exception& error)
+    {
+      GetEventLog().Post(EventLevel::Error, "Worker", error.what());
+      status = 1;
+    }
+    // Skip the parent's atexit handlers and static destructors, which belong to the parent
+    _exit(status);
+  }
+
+  void WorkerProcess::Wait(const std::atomic_bool& running)
+  {
+    int status = 0;
+    while (true)
+    {
+      if (!running.load(std::memory_order_acquire))
+      {
+        shared->StopRequested.store(true, std::memory_order_release);
+      }
+
+      pid_t result = waitpid(pid, &status, WNOHANG);
+      if (result == pid)
+      {
+        break;
+      }
+      if (result < 0 && errno != EINTR)
+      {
+        throw std::runtime_error(AppendErrorCode("Failed to wait for the RT worker process."));
+      }
+      std::this_thread::sleep_for(PollInterval);
+    }
+    pid = -1;
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+      std::string reason = WIFSIGNALED(status) ? "was killed by signal " + std::to_string(WTERMSIG(status))
+                                               : "exited with status " + std::to_string(WEXITSTATUS(status));
+      throw std::runtime_error("The RT worker process " + reason + ".");
+    }
+  }
+
+  void WorkerProcess::CopyResults(const TestParameters& params, ReportData& hardwareData, ReportData& softwareData) const
+  {
+    *params.SendData = shared->Send;
+    *params.ReceiveData = shared->Receive;
+    *params.SendOverhead = shared->SendOverhead;
+    *params.ReceiveOverhead = shared->ReceiveOverhead;
+    *params.Handoff = shared->Handoff;
+    for (size_t phase = 0; phase < CyclePhaseCount; ++phase)
+    {
+      if (params.Phases[phase] != nullptr) { *params.Phases[phase] = shared->Phases[phase]; }
+    }
+    hardwareData = shared->Hardware;
+    softwareData = shared->Software;
+  }
+} // end namespace Evaluator
@@ -0,0 +1,737 @@
+// Copyright (c) 2025 Robotic Systems Integration, Inc.
+// Licensed under the MIT License. See LICENSE file in the project root for details.
+
+// Unit tests for the measurement hot path and the file formats. Plain asserts, no framework:
+// each test throws on the first failed check and main() reports the failures.
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "allocationguard.h"
+#include "checkpoint.h"
+#include "cycletrace.h"
+#include "ethtool.h"
+#include "eventlog.h"
+#include "ftracesnapshot.h"
+#include "nictest.h"
+#include "nicthreads.h"
+#include "numa.h"
+#include "pingpong.h"
+#include "quantileestimator.h"
+#include "reporter.h"
+#include "rtarena.h"
+#include "scenario.h"
+#include "signalbench.h"
+#include "tailestimate.h"
+#include "timerlat.h"
+#include "timing.h"
+#include "waketimer.h"
+
+#define CHECK(condition) \
+  do { if (!(condition)) { throw std::runtime_error(std::string(__FILE__) + ":" + std::to_string(__LINE__) + ": CHECK(" #condition ") failed"); } } while (false)
+
+namespace
+{
+  using namespace Evaluator;
+
+  // Removes the file when the test is done, pass or fail
+  struct TemporaryFile
+  {
+    std::string Path;
+    explicit TemporaryFile(const std::string& name) : Path("/tmp/rmp-eval-tests-" + std::to_string(getpid()) + "-" + name) {}
+    ~TemporaryFile() { std::remove(Path.c_str()); }
+  };
+
+  void TestBucketIndex()
+  {
+    static constexpr uint64_t Width = 125;
+    CHECK(GetBucketIndex(0, Width, BucketCount) == 0);
+    CHECK(GetBucketIndex(Width - 1, Width, BucketCount) == 0);
+    CHECK(GetBucketIndex(Width, Width, BucketCount) == 1);
+    CHECK(GetBucketIndex(2 * Width - 1, Width, BucketCount) == 1);
+    CHECK(GetBucketIndex(2 * Width, Width, BucketCount) == 2);
+    CHECK(GetBucketIndex(4 * Width, Width, BucketCount) == 3);
+    CHECK(GetBucketIndex(8 * Width, Width, BucketCount) == 4);
+    CHECK(GetBucketIndex(1000 * Width, Width, BucketCount) == BucketCount - 1);
+  }
+
+  void TestQuantileEstimatorMedian()
+  {
+    std::vector<double> values(10001);
+    std::iota(values.begin(), values.end(), 0.0);
+    std::shuffle(values.begin(), values.end(), std::mt19937(42));
+
+    QuantileEstimator median(0.5);
+    for (double value : values)
+    {
+      median.AddObservation(value);
+    }
+    CHECK(std::abs(median.GetQuantile() - 5000.0) < 100.0);
+  }
+
+  void TestTimerReportStatistics()
+  {
+    ReportData upload;
+    TimerReport report(1000, 125, &upload);
+    const uint64_t observations[] = { 1000, 1100, 1200, 1500, 3000, 900 };
+    for (int index = 0; index < static_cast<int>(std::size(observations)); ++index)
+    {
+      report.AddObservation(observations[index], index);
+    }
+
+    ReportData data = report.Snapshot();
+    CHECK(data.observations == std::size(observations));
+    CHECK(data.min == 900 && data.minIndex == 5);
+    CHECK(data.max == 3000 && data.maxIndex == 4);
+    CHECK(data.sum == 8700);
+    // Latencies 0, 100, 200, 500, 2000 and an early wake (counted as 0)
+    CHECK(data.buckets[0] == 3);
+    CHECK(data.buckets[1] == 1);
+    CHECK(data.buckets[2] == 0);
+    CHECK(data.buckets[3] == 1);
+    CHECK(data.buckets[4] == 1);
+    CHECK(upload.observations == data.observations && upload.max == data.max);
+    CHECK(data.p99 == 0); // only estimated on request
+
+    TimerReport tracked(1000, 125);
+    tracked.TrackP99();
+    for (int index = 0; index < 1000; ++index)
+    {
+      tracked.AddObservation(1000 + index, index);
+    }
+    CHECK(std::abs(tracked.Snapshot().p99 - 1990) < 20);
+  }
+
+  void TestTimerReportRestore()
+  {
+    TimerReport first(1000, 125);
+    first.AddObservation(1000, 0);
+    first.AddObservation(5000, 1);
+    first.SetPageFaults(2, 0);
+
+    TimerReport resumed(1000, 125);
+    resumed.Restore(first.Snapshot());
+    resumed.AddObservation(1100, 0);
+    resumed.AddObservation(6000, 1);
+
+    ReportData data = resumed.Snapshot();
+    CHECK(data.observations == 4);
+    CHECK(data.sum == 13100);
+    CHECK(data.max == 6000 && data.maxIndex == 3); // indices continue after the restored observations
+    CHECK(data.buckets[0] == 2 && data.buckets[4] == 2);
+    CHECK(data.minorPageFaults == 2);
+  }
+
+  void TestOverheadReport()
+  {
+    ReportData upload;
+    OverheadReport overhead(1000, &upload);
+    overhead.AddObservation(100, 0);
+    overhead.AddObservation(300, 1);
+    overhead.AddObservation(2600, 2);
+
+    CHECK(upload.isOverhead);
+    CHECK(upload.observations == 3 && upload.target == 0);
+    CHECK(upload.max == 2600 && upload.maxIndex == 2);
+    CHECK(upload.median == 1000.0); // holds the mean
+    CHECK(upload.buckets[0] == 2 && upload.buckets[2] == 1);
+  }
+
+  void TestReportPublishing()
+  {
+    // Every published copy has min == max == observations, so a torn read shows up as a mismatch
+    static constexpr uint64_t Publications = 200'000;
+    ReportData upload;
+    upload.min = 0; // consistent before the first publication too
+    std::atomic_bool done = false;
+    std::thread writer([&upload, &done]
+    {
+      ReportData data;
+      for (uint64_t count = 1; count <= Publications; ++count)
+      {
+        data.min = data.max = data.observations = count;
+        PublishReportData(upload, data);
+      }
+      done.store(true, std::memory_order_release);
+    });
+
+    bool consistent = true;
+    uint64_t last = 0;
+    while (!done.load(std::memory_order_acquire))
+    {
+      const ReportData copy = ReadReportData(upload);
+      consistent = consistent && copy.min == copy.observations && copy.max == copy.observations && copy.observations >= last;
+      last = copy.observations;
+    }
+    writer.join();
+    CHECK(consistent);
+    CHECK(ReadReportData(upload).observations == Publications);
+    CHECK(upload.sequence == 2 * Publications);
+  }
+
+  void TestCyclePhaseTimer()
+  {
+    ReportData upload;
+    OverheadReport phase(1000, &upload, true);
+    {
+      ScopedTimer timer(phase, false, 0);
+    }
+    CHECK(upload.observations == 0);
+    {
+      ScopedTimer timer(phase, true, 1);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(upload.observations == 1 && upload.maxIndex == 1);
+    CHECK(upload.isOverhead && upload.isPhase);
+    CHECK(upload.max >= 1'000'000 && upload.buckets[BucketCount - 1] == 1);
+
+    // A long phase is the measurement, not instrumentation cost, so it is not flagged
+    TableMaker tableMaker = TableMaker::CreateTableMaker(1000, false);
+    std::ostringstream phaseOutput;
+    tableMaker.PrintOverheadSummary(phaseOutput, "Sender wake", upload);
+    CHECK(phaseOutput.str().find("WARNING") == std::string::npos);
+    upload.isPhase = false;
+    std::ostringstream overheadOutput;
+    tableMaker.PrintOverheadSummary(overheadOutput, "Sender overhead", upload);
+    CHECK(overheadOutput.str().find("WARNING") != std::string::npos);
+  }
+
+  void TestCpuMask()
+  {
+    CHECK(FormatCpuMask({ 0 }) == "1");
+    CHECK(FormatCpuMask({ 3, 5 }) == "28");
+    CHECK(FormatCpuMask({ 31 }) == "80000000");
+    CHECK(FormatCpuMask({ 2, 33 }) == "2,00000004");
+    CHECK(FormatCpuMask({ 0, 33 }) == "2,00000001");
+    CHECK(FormatCpuMask({ 64 }) == "1,00000000,00000000");
+  }
+
+  void TestSnapshotDecision()
+  {
+    CHECK(DecideSnapshot(999, 1000, false, 0) == SnapshotDecision::Ignore);
+    CHECK(DecideSnapshot(999, 1000, true, MaximumSnapshots) == SnapshotDecision::Ignore);
+    CHECK(DecideSnapshot(1000, 1000, false, 0) == SnapshotDecision::Take);
+    CHECK(DecideSnapshot(5000, 1000, true, 0) == SnapshotDecision::Skip);
+    CHECK(DecideSnapshot(5000, 1000, false, MaximumSnapshots - 1) == SnapshotDecision::Take);
+    CHECK(DecideSnapshot(5000, 1000, false, MaximumSnapshots) == SnapshotDecision::Skip);
+  }
+
+  void TestTimerlatParsing()
+  {
+    auto irq = ParseTimerlatLine("          <idle>-0       [003] d.h1.    54.029328: #1     context    irq timer_latency       932 ns");
+    CHECK(irq && irq->Context == TimerlatContext::Irq && irq->Sequence == 1 && irq->Nanoseconds == 932);
+    auto thread = ParseTimerlatLine("     timerlat/3-1443    [003] .....    54.029337: #1     context thread timer_latency     11700 ns");
+    CHECK(thread && thread->Context == TimerlatContext::Thread && thread->Sequence == 1 && thread->Nanoseconds == 11700);
+    auto micro = ParseTimerlatLine("     timerlat/3-1443    [003] .....    54.030337: #2     context thread timer_latency        12 us");
+    CHECK(micro && micro->Sequence == 2 && micro->Nanoseconds == 12000);
+
+    CHECK(!ParseTimerlatLine("# tracer: timerlat"));
+    CHECK(!ParseTimerlatLine("#                                _-----=> irqs-off/BH-disabled"));
+    CHECK(!ParseTimerlatLine("  rtla-1500 [003] .....  54.1: #3 context user-ret timer_latency 15000 ns"));
+    CHECK(!ParseTimerlatLine("  <idle>-0 [003] d.h1.  54.1: #4 context irq timer_latency"));
+  }
+
+  void TestHandoffHistogram()
+  {
+    HandoffHistogram histogram;
+    histogram.AddObservation(400, 0);
+    histogram.AddObservation(1500, 1);
+    histogram.AddObservation(3000, 2);
+    histogram.AddObservation(5'000'000, 3);
+    histogram.unblocked = 2;
+
+    CHECK(histogram.observations == 4 && histogram.max == 5'000'000 && histogram.maxIndex == 3);
+    CHECK(histogram.bins[0] == 1 && histogram.bins[1] == 1 && histogram.bins[2] == 1 && histogram.bins[HandoffBinCount - 1] == 1);
+
+    std::ostringstream output;
+    PrintHandoffHistogram(output, "Wake", histogram);
+    const std::string text = output.str();
+    CHECK(text.find("Wake: 4 handoffs") == 0);
+    CHECK(text.find("1-2us") != std::string::npos);
+    CHECK(text.find(">= 1024us") != std::string::npos);
+    CHECK(text.find("2 cycles") != std::string::npos);
+  }
+
+  void TestPingPongMatrix()
+  {
+    std::vector<PingPongResult> results(3);
+    results[0].Cpu = 1;
+    results[0].Median = 240;
+    results[0].Relation = "other package";
+    results[1].Cpu = 2;
+    results[1].Error = "CPU 2 stopped answering after 0 round trips";
+    results[2].Cpu = 3;
+    results[2].Median = 80;
+    results[2].Relation = "SMT sibling";
+
+    std::ostringstream output;
+    PrintPingPongMatrix(output, 0, results);
+    const std::string text = output.str();
+    CHECK(text.find("failed: CPU 2 stopped answering") != std::string::npos);
+    CHECK(text.find("Lowest median: CPU 3 (SMT sibling), 80 ns") != std::string::npos);
+
+    // Nothing to reduce, so no threads are started
+    const PingPongResult empty = MeasureCacheLinePingPong(0, 0, 1, 0);
+    CHECK(!empty.Error.empty() && empty.Median == 0 && empty.Max == 0);
+  }
+
+  void TestSignalLatency()
+  {
+    // Both sides on one CPU, so wakes are often late; each must still be timed against its own signal
+    static constexpr uint64_t Wakeups = 50;
+    const int cpu = GetAllowedCpus().front();
+    SignalBenchResult result = MeasureSignalLatency(SignalMechanism::Futex, cpu, 80, cpu, 81, 100'000, Wakeups);
+    if (!result.Error.empty() && geteuid() != 0)
+    {
+      return; // SCHED_FIFO threads need privileges this run doesn't have
+    }
+    CHECK(result.Error.empty());
+    CHECK(result.Latency.observations == Wakeups);
+    CHECK(result.Latency.max < NanoPerSec);
+  }
+
+  void TestSignalMechanisms()
+  {
+    for (SignalMechanism mechanism : AllSignalMechanisms)
+    {
+      CHECK(ParseSignalMechanism(GetSignalMechanismName(mechanism)) == mechanism);
+
+      // A signal sent before the waiter blocks must not be lost
+      std::unique_ptr<ISignal> signal = CreateSignal(mechanism);
+      signal->Signal();
+      signal->Wait();
+
+      std::thread waiter([&signal] { signal->Wait(); });
+      signal->Signal();
+      waiter.join();
+    }
+    CHECK(!ParseSignalMechanism("semaphore"));
+  }
+
+  void TestPeriodicity()
+  {
+    // 60 s of 10 ms windows: 0-5us of noise, a 40us spike every 1 s and an 80us one every 4 s
+    static constexpr uint64_t Window = 10'000'000;
+    static constexpr uint64_t Microsecond = 1000;
+    std::mt19937 random(3);
+    std::uniform_int_distribution<uint64_t> noise(0, 5 * Microsecond);
+    LatencySeries series(1 << 13, 1 << 8);
+    series.Reset(Window, 30 * Microsecond);
+    for (uint64_t window = 0; window < 6000; ++window)
+    {
+      const uint64_t time = 1'000'000'000 + window * Window + 1'000'000;
+      series.Add(time, noise(random));
+      if (window % 100 == 37) { series.Add(time + 1000, 40 * Microsecond); }
+      if (window % 400 == 250) { series.Add(time + 2000, 80 * Microsecond); }
+    }
+    const std::vector<uint64_t> windows = series.GetWindows();
+    CHECK(windows.size() == 6000 && windows[37] == 40 * Microsecond && windows[250] == 80 * Microsecond);
+    CHECK(series.SpikeCount() == 75 && series.GetSpikeTimes().size() == 75);
+
+    auto components = FindPeriodicComponents(windows, Window, series.GetSpikeTimes());
+    CHECK(components.size() == 2);
+    CHECK(std::abs(components[0].PeriodSeconds - 4.0) < 0.001 && components[0].Amplitude > 70 * Microsecond);
+    CHECK(std::abs(components[1].PeriodSeconds - 1.0) < 0.001 && components[1].Amplitude > 30 * Microsecond);
+    CHECK(components[1].MatchedSpikes > 50);
+
+    // Noise alone has no period
+    std::vector<uint64_t> quiet(6000);
+    for (uint64_t& window : quiet) { window = noise(random); }
+    CHECK(FindPeriodicComponents(quiet, Window, {}).empty());
+  }
+
+  void TestTailEstimate()
+  {
+    // One block per second of cycles at 1 kHz, with the block maximum of (period - target)
+    TimerReport report(1000000, 125000);
+    for (int index = 0; index < 2500; ++index)
+    {
+      report.AddObservation(index == 1500 ? 1300000 : 1000000, index);
+    }
+    ReportData data = report.Snapshot();
+    CHECK(data.blockCycles == 1000 && data.blocks == 2 && data.blockMaxSum == 300000);
+    CHECK(!FitGumbel(data));
+
+    // Gumbel(mu = 100us, beta = 10us) maxima: the fit recovers the parameters and brackets the true tail
+    static constexpr double Location = 100000;
+    static constexpr double Scale = 10000;
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> uniform(1e-9, 1.0);
+    data.blocks = 2000;
+    data.blockMaxSum = 0;
+    data.blockMaxSumSquares = 0;
+    for (uint64_t block = 0; block < data.blocks; ++block)
+    {
+      const double maximum = Location - Scale * std::log(-std::log(uniform(random)));
+      data.blockMaxSum += maximum;
+      data.blockMaxSumSquares += maximum * maximum;
+    }
+    auto fit = FitGumbel(data);
+    CHECK(fit && std::abs(fit->Location - Location) < 0.05 * Location && std::abs(fit->Scale - Scale) < 0.1 * Scale);
+    CHECK(fit->BlockSeconds == 1.0);
+
+    const double expected = -std::expm1(-std::exp(-5.0)); // threshold at y = 5
+    ExceedanceEstimate estimate = EstimateExceedance(*fit, static_cast<uint64_t>(Location + 5 * Scale));
+    CHECK(estimate.ProbabilityLow < estimate.Probability && estimate.Probability < estimate.ProbabilityHigh);
+    CHECK(estimate.ProbabilityLow < expected && expected < estimate.ProbabilityHigh);
+    CHECK(std::abs(estimate.SecondsBetween * estimate.Probability - 1.0) < 1e-9);
+    CHECK(estimate.SecondsBetweenLow < estimate.SecondsBetween && estimate.SecondsBetween < estimate.SecondsBetweenHigh);
+
+    CHECK(DescribeInterval(4.25) == "4.2 s" || DescribeInterval(4.25) == "4.3 s");
+    CHECK(DescribeInterval(3 * 3600) == "3.0 h");
+    CHECK(DescribeInterval(std::numeric_limits<double>::infinity()) == "> 1000 years");
+  }
+
+  void TestTimerAudit()
+  {
+    const std::string config = "CONFIG_NO_HZ_FULL=y\n# CONFIG_HZ_250 is not set\nCONFIG_HZ_1000=y\nCONFIG_HZ=1000\nCONFIG_HIGH_RES_TIMERS=y\n";
+    CHECK(ParseKernelConfigOption(config, "HZ") == "1000");
+    CHECK(ParseKernelConfigOption(config, "HIGH_RES_TIMERS") == "y");
+    CHECK(!ParseKernelConfigOption(config, "PREEMPT_RT"));
+
+    auto costs = MeasureClockReadCosts();
+    auto monotonic = std::find_if(costs.begin(), costs.end(), [](const ClockReadCost& cost) { return cost.Clock == CLOCK_MONOTONIC; });
+    CHECK(monotonic != costs.end() && monotonic->Resolution > 0 && monotonic->Nanoseconds > 0);
+    CHECK(DescribeClockReadCosts(costs).find("MONOTONIC ") == 0);
+  }
+
+  void TestEventLog()
+  {
+    static constexpr int Producers = 4;
+    static constexpr const char* ProducerNames[Producers] = { "P0", "P1", "P2", "P3" };
+    static constexpr int EventsPerProducer = 200;
+    EventLog log(Producers * EventsPerProducer);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < Producers; ++producer)
+    {
+      producers.emplace_back([&log, producer]
+      {
+        for (int index = 0; index < EventsPerProducer; ++index)
+        {
+          log.Post(EventLevel::Threshold, ProducerNames[producer], "event", index);
+        }
+      });
+    }
+    for (auto& thread : producers) { thread.join(); }
+
+    std::ostringstream output;
+    CHECK(log.Drain(output, 0, false) == Producers * EventsPerProducer);
+    CHECK(log.Dropped() == 0);
+
+    // Full ring: extra events are counted and reported instead of blocking
+    EventLog small(2);
+    CHECK(small.Post(EventLevel::Error, "Receiver", "first"));
+    CHECK(small.Post(EventLevel::State, "Receiver", "second"));
+    CHECK(!small.Post(EventLevel::Error, "Receiver", "third"));
+    std::ostringstream smallOutput;
+    CHECK(small.Drain(smallOutput, 0, false) == 2); // the state event is hidden, the drop is reported
+    CHECK(smallOutput.str().find("first") != std::string::npos);
+    CHECK(smallOutput.str().find("second") == std::string::npos);
+    CHECK(smallOutput.str().find("1 events dropped") != std::string::npos);
+  }
+
+  void TestRtArena()
+  {
+    RtArena arena(4096);
+    {
+      RtSection section("Test");
+      std::pmr::vector<uint64_t> samples(&arena);
+      samples.reserve(64);
+      samples.push_back(1);
+      CHECK(arena.Used() >= 64 * sizeof(uint64_t));
+    }
+    CHECK(GetRtAllocationCount() == 0); // the arena never reaches malloc
+
+    arena.Reset();
+    bool threw = false;
+    try { CHECK(arena.allocate(8192) == nullptr); } catch (const std::bad_alloc&) { threw = true; }
+    CHECK(threw);
+  }
+
+  void TestAllocationGuard()
+  {
+    SetAllocationGuardMode(AllocationGuardMode::Count);
+    const uint64_t before = GetRtAllocationCount();
+    {
+      RtSection section("Test");
+      auto allocated = std::make_unique<std::string>(64, 'x');
+      CHECK(allocated->size() == 64);
+    }
+    auto unguarded = std::make_unique<int>(0); // outside a section, never counted
+    SetAllocationGuardMode(AllocationGuardMode::Off);
+
+    std::ostringstream events;
+    GetEventLog().Drain(events, 0, false);
+    if (IsAllocationGuardAvailable())
+    {
+      CHECK(GetRtAllocationCount() - before == 2); // the string object and its buffer
+      CHECK(events.str().find("2 heap allocations inside the RT loop") != std::string::npos);
+    }
+    else
+    {
+      CHECK(GetRtAllocationCount() == before);
+    }
+  }
+
+  void TestMemoryNodeParsing()
+  {
+    for (int node : { LocalMemoryNode, UnboundMemoryNode, 0, 3 })
+    {
+      CHECK(ParseMemoryNode(GetMemoryNodeName(node)) == node);
+    }
+    CHECK(!ParseMemoryNode("-1"));
+    CHECK(!ParseMemoryNode("1x"));
+    CHECK(ResolveMemoryNode(UnboundMemoryNode, 0) == UnboundMemoryNode);
+    CHECK(ResolveMemoryNode(2, 0) == 2);
+
+    // An arena bound to the node of CPU 0 is usable wherever the kernel has NUMA support
+    if (auto node = GetCpuNumaNode(0))
+    {
+      RtArena arena(4096, *node);
+      CHECK(arena.allocate(64) != nullptr);
+    }
+  }
+
+  void TestRtCoalescing()
+  {
+    ethtool_coalesce settings = {};
+    settings.rx_coalesce_usecs = 50;
+    settings.rx_max_coalesced_frames = 8;
+    settings.tx_max_coalesced_frames = 0; // unsupported by the driver, must stay 0
+    settings.use_adaptive_rx_coalesce = 1;
+    CHECK(DelaysReceive(settings));
+
+    ethtool_coalesce rt = GetRtCoalescing(settings);
+    CHECK(!DelaysReceive(rt));
+    CHECK(rt.rx_coalesce_usecs == 0 && rt.rx_max_coalesced_frames == 1 && rt.tx_max_coalesced_frames == 0);
+    CHECK(DescribeCoalescing(rt) == "rx-usecs 0 rx-frames 1 tx-usecs 0 tx-frames 0 adaptive-rx off adaptive-tx off");
+    CHECK(ParseCoalescingMode(GetCoalescingModeName(CoalescingMode::Rt)) == CoalescingMode::Rt);
+
+    // The ioctl's errno travels with the exception
+    int error = 0;
+    try { GetCoalescing("rmp-eval-none"); } catch (const EthtoolError& failure) { error = failure.Error; }
+    CHECK(error == ENODEV);
+  }
+
+  void TestNicSweepGrid()
+  {
+    auto points = ParseNicSweepGrid("rx-usecs=0,16,64;rx-ring=64,256");
+    CHECK(points.size() == 6);
+    CHECK(DescribeNicSettings(points[0]) == "rx-usecs 0 rx-ring 64");
+    CHECK(DescribeNicSettings(points[1]) == "rx-usecs 0 rx-ring 256");
+    CHECK(DescribeNicSettings(points[5]) == "rx-usecs 64 rx-ring 256");
+
+    for (const char* invalid : { "", "rx-usecs", "rx-usecs=", "rx-usecs=1,x", "rx-speed=1", "rx-usecs=1;rx-usecs=2" })
+    {
+      bool threw = false;
+      try { ParseNicSweepGrid(invalid); } catch (const std::runtime_error&) { threw = true; }
+      CHECK(threw);
+    }
+  }
+
+  void TestNicKernelThreadMatching()
+  {
+    const std::string interrupts =
+      "           CPU0       CPU1\n"
+      " 125:         10          0  IR-PCI-MSI 1048576-edge      enp2s0-TxRx-0\n"
+      " 126:          0          4  IR-PCI-MSI 1048577-edge      enp2s0\n"
+      " 127:          3          0  IR-PCI-MSI 1048578-edge      enp2s01\n"
+      " 128:          1          0  IR-PCI-MSI 1048579-edge      venp2s0\n";
+    const std::set<int> irqs = ParseNicIrqs(interrupts, "enp2s0");
+    CHECK(irqs == std::set<int>({ 125, 126 }));
+
+    CHECK(IsNicKernelThread("irq/125-enp2s0-", "enp2s0", irqs));
+    CHECK(!IsNicKernelThread("irq/127-enp2s01", "enp2s0", irqs));
+    CHECK(!IsNicKernelThread("irq/12-enp2s0", "enp2s0", irqs));
+    CHECK(IsNicKernelThread("napi/enp2s0-81", "enp2s0", irqs));
+    CHECK(IsNicKernelThread("napi/enp2s0-8193", "enp2s0", irqs));
+    CHECK(IsNicKernelThread("napi/enp88s0f1n", "enp88s0f1np0", irqs)); // truncated to 15 characters
+    CHECK(!IsNicKernelThread("napi/enp2s01-81", "enp2s0", irqs));
+    CHECK(GetRecommendedNicThreadPriority(42, 45) == 41);
+  }
+
+  void TestProbeFrame()
+  {
+    ProbeFrame frame;
+    frame.fill(0xaa);
+    BuildProbeFrame(frame);
+    CHECK(std::all_of(frame.begin(), frame.begin() + 6, [](unsigned char byte) { return byte == 0xff; }));
+    CHECK(std::all_of(frame.begin() + 6, frame.begin() + 12, [](unsigned char byte) { return byte == 0x00; }));
+    CHECK(frame[12] == 0x88 && frame[13] == 0xa4);
+    CHECK(frame[15] == 0x10 && frame[16] == 0x08);
+    CHECK(frame[22] == 0x01);
+    CHECK(frame[ProbeFrameSize - 1] == 0x00);
+  }
+
+  void TestCheckpointRoundTrip()
+  {
+    TimerReport report(1000000, 125000);
+    report.AddObservation(1000500, 0);
+    report.AddObservation(1400000, 1);
+
+    Checkpoint saved;
+    saved.Period = 1000000;
+    saved.BucketWidth = 125000;
+    saved.Rows.emplace_back("HW delta", report.Snapshot());
+
+    TemporaryFile file("checkpoint");
+    SaveCheckpoint(file.Path, saved);
+    Checkpoint loaded = LoadCheckpoint(file.Path);
+
+    CHECK(loaded.Period == saved.Period && loaded.BucketWidth == saved.BucketWidth);
+    const ReportData* row = loaded.Find("HW delta");
+    CHECK(row != nullptr);
+    CHECK(row->observations == 2 && row->max == 1400000 && row->maxIndex == 1);
+    CHECK(std::equal(std::begin(row->buckets), std::end(row->buckets), std::begin(saved.Rows[0].second.buckets)));
+    CHECK(loaded.Find("Receiver") == nullptr);
+
+    // The block maxima of the tail estimate survive the round trip and continue after Restore()
+    ReportData blocks = saved.Rows[0].second;
+    blocks.blocks = 3;
+    blocks.blockMaxSum = 1200.5;
+    blocks.blockMaxSumSquares = 480200.25;
+    saved.Rows[0].second = blocks;
+    SaveCheckpoint(file.Path, saved);
+    row = LoadCheckpoint(file.Path).Find("HW delta");
+    CHECK(row->blocks == 3 && row->blockMaxSum == 1200.5 && row->blockMaxSumSquares == 480200.25);
+
+    TimerReport resumed(NanoPerSec, 125000); // one-second period, so every cycle closes a block
+    resumed.Restore(*row);
+    resumed.AddObservation(NanoPerSec + 100, 0);
+    const ReportData merged = resumed.Snapshot();
+    CHECK(merged.blocks == 4 && merged.blockMaxSum == 1300.5 && merged.blockMaxSumSquares == 480200.25 + 100.0 * 100.0);
+  }
+
+  void TestCycleReplay()
+  {
+    // Full ring: extra cycles are counted and dropped, flushing makes room again
+    TemporaryFile file("cycles");
+    CycleTrace trace(file.Path, 1000000, 4);
+    for (uint64_t lateness = 1; lateness <= 5; ++lateness)
+    {
+      CHECK(trace.Record(lateness * 1000) == (lateness <= 4));
+    }
+    CHECK(trace.Flush() == 4 && trace.Dropped() == 1);
+    CHECK(trace.Record(950000) && trace.Record(10000));
+    trace.Close();
+    CycleRecording recording = LoadCycleRecording(file.Path);
+    CHECK(recording.Period == 1000000 && recording.Dropped == 1);
+    CHECK((recording.Lateness == std::vector<uint64_t>{ 1000, 2000, 3000, 4000, 950000, 10000 }));
+
+    // Steady 10us lateness fits a 100us budget at 1 kHz with 890us to spare
+    const std::vector<uint64_t> steady(8, 10000);
+    ReplayResult result = ReplayCycles(steady, 1000000, 100000);
+    CHECK(result.Passed() && result.Misses == 0 && result.MinSlack == 890000 && result.MaxLatency == 0);
+
+    // One cycle 950us late: without compute it still meets its deadline, but the 940us gap to the
+    // previous cycle is in the same category the live tool would report
+    std::vector<uint64_t> spike = steady;
+    spike[4] = 950000;
+    result = ReplayCycles(spike, 1000000, 0);
+    CHECK(result.Misses == 0 && result.MaxLatency == 940000 && !result.Passed());
+    CHECK(GetBucketIndex(result.MaxLatency, result.BucketWidth, BucketCount) == GetBucketIndex(940000, 125000, BucketCount));
+
+    // With a 100us budget it misses by 50us, and the next cycle starts late because of it
+    result = ReplayCycles(spike, 1000000, 100000);
+    CHECK(result.Misses == 1 && result.MinSlack == -50000 && !result.Passed());
+  }
+
+  void TestScenarioParsing()
+  {
+    TemporaryFile file("scenario.ini");
+    std::ofstream(file.Path) << "# defaults\nnic = none\nperiod = 500\n\n[idle]\nduration = 2m\n\n[load]\nduration = 1h\nload = true\n";
+
+    auto phases = LoadScenario(file.Path);
+    CHECK(phases.size() == 2);
+    CHECK(phases[0].Name == "idle" && phases[0].DurationSeconds == 120);
+    CHECK(phases[1].DurationSeconds == 3600 && phases[1].Load == "true");
+    CHECK(phases[1].PeriodMicroseconds == 500u && phases[1].NicName == "none");
+
+    std::ofstream(file.Path) << "[broken]\nduration = soon\n";
+    bool threw = false;
+    try { LoadScenario(file.Path); } catch (const std::runtime_error&) { threw = true; }
+    CHECK(threw);
+  }
+
+  void TestWakeMechanismNames()
+  {
+    for (WakeMechanism mechanism : AllWakeMechanisms)
+    {
+      CHECK(ParseWakeMechanism(GetWakeMechanismName(mechanism)) == mechanism);
+    }
+    CHECK(!ParseWakeMechanism("sundial"));
+  }
+} // end namespace
+
+
+
+int main()
+{
+  const std::pair<const char*, std::function<void()>> tests[] = {
+    { "BucketIndex", TestBucketIndex },
+    { "QuantileEstimatorMedian", TestQuantileEstimatorMedian },
+    { "TimerReportStatistics", TestTimerReportStatistics },
+    { "TimerReportRestore", TestTimerReportRestore },
+    { "OverheadReport", TestOverheadReport },
+    { "ReportPublishing", TestReportPublishing },
+    { "CyclePhaseTimer", TestCyclePhaseTimer },
+    { "CpuMask", TestCpuMask },
+    { "SnapshotDecision", TestSnapshotDecision },
+    { "TimerlatParsing", TestTimerlatParsing },
+    { "HandoffHistogram", TestHandoffHistogram },
+    { "PingPongMatrix", TestPingPongMatrix },
+    { "SignalMechanisms", TestSignalMechanisms },
+    { "SignalLatency", TestSignalLatency },
+    { "Periodicity", TestPeriodicity },
+    { "TailEstimate", TestTailEstimate },
+    { "TimerAudit", TestTimerAudit },
+    { "EventLog", TestEventLog },
+    { "RtArena", TestRtArena },
+    { "AllocationGuard", TestAllocationGuard },
+    { "MemoryNodeParsing", TestMemoryNodeParsing },
+    { "RtCoalescing", TestRtCoalescing },
+    { "NicSweepGrid", TestNicSweepGrid },
+    { "NicKernelThreadMatching", TestNicKernelThreadMatching },
+    { "ProbeFrame", TestProbeFrame },
+    { "CheckpointRoundTrip", TestCheckpointRoundTrip },
+    { "CycleReplay", TestCycleReplay },
+    { "ScenarioParsing", TestScenarioParsing },
+    { "WakeMechanismNames", TestWakeMechanismNames },
+  };
+
+  int failures = 0;
+  for (const auto& [name, test] : tests)
+  {
+    try
+    {
+      test();
+      std::cout << "[ PASS ] " << name << "\n";
+    }
+    catch (const std::exception& error)
+    {
+      std::cout << "[ FAIL ] " << name << ": " << error.what() << "\n";
+      ++failures;
+    }
+  }
+  std::cout << std::size(tests) - failures << "/" << std::size(tests) << " tests passed\n";
+  return failures == 0 ? 0 : 1;
+}